@@ -0,0 +1,157 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+
+#include "i8080.h"
+#include "video.h"
+
+static const int MEMORY_SIZE = 0x10000;
+static const long DEFAULT_INSTRUCTION_COUNT = 50000000L;
+static const int VIDEO_FRAME_COUNT = 2000;
+static uint8_t* memory;
+
+// the header-only core with memory accesses inlined, compared against the callbacks in libi8080
+#define I8080_FLAT_MEMORY memory
+#include "i8080_inline.h"
+
+// A tight loop at 0x0100 that exercises the register pairs, the PSW and the ALU
+// flag computation: PUSH/POP, INX/DCX, DAD, XCHG and the arithmetic/logical group.
+static const uint8_t BENCH_PROGRAM[] = {
+    0x31, 0x00, 0xf0, // LXI SP, #0xf000
+    0x01, 0x34, 0x12, // LXI B, #0x1234
+    0x11, 0x01, 0x00, // LXI D, #0x0001
+    0x21, 0x00, 0x20, // LXI H, #0x2000
+    0xc5,             // loop: PUSH B
+    0xf5,             // PUSH PSW
+    0x23,             // INX H
+    0x19,             // DAD D
+    0xeb,             // XCHG
+    0xeb,             // XCHG
+    0x7e,             // MOV A, M
+    0x80,             // ADD B
+    0x89,             // ADC C
+    0x92,             // SUB D
+    0xa3,             // ANA E
+    0xad,             // XRA L
+    0xb4,             // ORA H
+    0xfe, 0x55,       // CPI #0x55
+    0x77,             // MOV M, A
+    0x17,             // RAL
+    0x0c,             // INR C
+    0x0b,             // DCX B
+    0xf1,             // POP PSW
+    0xc1,             // POP B
+    0xc3, 0x0c, 0x01  // JMP loop
+};
+
+static uint8_t read_byte(uint16_t address);
+static void write_byte(uint16_t address, uint8_t byte);
+static double elapsed_seconds(const struct timespec* start, const struct timespec* end);
+static double bench_core(long instruction_count, bool inlined);
+static void bench_video(void);
+
+int main(int argc, char* argv[]) {
+    long instruction_count = argc > 1 ? atol(argv[1]) : DEFAULT_INSTRUCTION_COUNT;
+    if(instruction_count <= 0) {
+        printf("Usage: %s [instruction count]\n", argv[0]);
+        return 1;
+    }
+
+    memory = calloc(MEMORY_SIZE, sizeof(uint8_t));
+    if(memory == NULL) {
+        printf("Error could not allocate memory\n");
+        return 1;
+    }
+
+    double seconds = bench_core(instruction_count, false);
+    printf("Executed %ld instructions in %.3lf seconds\n", instruction_count, seconds);
+    printf("%.2lf million instructions per second\n", instruction_count / seconds / 1e6);
+
+    double inlined_seconds = bench_core(instruction_count, true);
+    printf("Inlined flat memory: %.2lf million instructions per second (%.2lfx)\n",
+           instruction_count / inlined_seconds / 1e6, seconds / inlined_seconds);
+    printf("State size: %zu bytes\n", sizeof(i8080_t));
+
+    bench_video();
+    free(memory);
+
+    return 0;
+}
+
+uint8_t read_byte(uint16_t address) {
+    return memory[address];
+}
+
+void write_byte(uint16_t address, uint8_t byte) {
+    memory[address] = byte;
+}
+
+double elapsed_seconds(const struct timespec* start, const struct timespec* end) {
+    return (end->tv_sec - start->tv_sec) + (end->tv_nsec - start->tv_nsec) / 1e9;
+}
+
+double bench_core(long instruction_count, bool inlined) {
+    // the loop stores through HL all over memory, so every run starts from a fresh copy
+    memset(memory, 0, MEMORY_SIZE);
+    for(size_t i = 0; i < sizeof(BENCH_PROGRAM); ++i) {
+        memory[0x0100 + i] = BENCH_PROGRAM[i];
+    }
+
+    i8080_t* i8080 = init_i8080(0x0100);
+    i8080->read_byte = read_byte;
+    i8080->write_byte = write_byte;
+
+    struct timespec start_time, end_time;
+    timespec_get(&start_time, TIME_UTC);
+
+    if(inlined) {
+        for(long i = 0; i < instruction_count; ++i) {
+            decode_i8080_inline(i8080);
+        }
+    } else {
+        for(long i = 0; i < instruction_count; ++i) {
+            decode_i8080(i8080);
+        }
+    }
+
+    timespec_get(&end_time, TIME_UTC);
+    free_i8080(i8080);
+    return elapsed_seconds(&start_time, &end_time);
+}
+
+void bench_video(void) {
+    // converts a 1-bpp 256x224 screen at 0x2400, once with every line dirty and once
+    // with a static screen where a single byte changes per frame
+    video_t* video = init_video(memory, 0x2400, 256, 224, false);
+    if(video == NULL) {
+        printf("Error could not create the video device\n");
+        return;
+    }
+
+    struct timespec start_time, end_time;
+
+    timespec_get(&start_time, TIME_UTC);
+    for(int frame = 0; frame < VIDEO_FRAME_COUNT; ++frame) {
+        video_invalidate(video);
+        video_update(video);
+    }
+    timespec_get(&end_time, TIME_UTC);
+    double full_seconds = elapsed_seconds(&start_time, &end_time);
+
+    timespec_get(&start_time, TIME_UTC);
+    for(int frame = 0; frame < VIDEO_FRAME_COUNT; ++frame) {
+        uint16_t address = 0x2400 + (frame * 97) % video->vram_size;
+        write_byte(address, memory[address] ^ 0xff);
+        video_notify_write(video, address);
+        video_update(video);
+    }
+    timespec_get(&end_time, TIME_UTC);
+    double static_seconds = elapsed_seconds(&start_time, &end_time);
+
+    printf("Video full frame: %.2lf microseconds per frame\n", full_seconds / VIDEO_FRAME_COUNT * 1e6);
+    printf("Video static frame: %.2lf microseconds per frame\n", static_seconds / VIDEO_FRAME_COUNT * 1e6);
+
+    free_video(video);
+}
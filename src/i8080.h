@@ -4,18 +4,54 @@
 typedef unsigned char uint8_t;
 typedef unsigned short uint16_t;
 
+// Flag bit positions in the PSW (low byte of the A/F pair):
+//
+// Bit Position: 7  6  5  4  3  2  1  0
+//               S  Z  0  AC 0  P  1  CY
+#define FLAG_S  0x80
+#define FLAG_Z  0x40
+#define FLAG_AC 0x10
+#define FLAG_P  0x04
+#define FLAG_CY 0x01
+
+// bits 5 and 3 always read as 0 and bit 1 always reads as 1
+#define FLAGS_FIXED_MASK 0xd5
+#define FLAGS_FIXED_SET  0x02
+
+// A register pair that can be accessed either as a 16-bit word or as its
+// two 8-bit halves, e.g. `i8080->hl` and `i8080->h` / `i8080->l`.
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    #define I8080_REGISTER_PAIR(high, low) union { uint16_t high##low; struct { uint8_t high, low; }; }
+#else
+    #define I8080_REGISTER_PAIR(high, low) union { uint16_t high##low; struct { uint8_t low, high; }; }
+#endif
+
+// The whole state is aligned to and fits in a single 64-byte cache line so
+// that a snapshot or context switch is one memcpy of sizeof(i8080_t).
 typedef struct i8080_t {
-    uint8_t a, b, c, d, e, h, l;
+    _Alignas(64) I8080_REGISTER_PAIR(a, f); // af is the PSW, f holds the packed flags
+    I8080_REGISTER_PAIR(b, c);
+    I8080_REGISTER_PAIR(d, e);
+    I8080_REGISTER_PAIR(h, l);
     uint16_t sp, pc;
-    _Bool s, z, ac, p, cy;
     _Bool interrupt_enabled;
-    
+    _Bool interrupt_pending;   // set by EI, interrupts are enabled once the next instruction starts
+    _Bool halted;
+
     uint8_t (*read_byte)(uint16_t);
     void (*write_byte)(uint16_t, uint8_t);
+
+    // optional port handlers for IN/OUT, io_context is passed through to them
+    void* io_context;
+    uint8_t (*read_port)(void*, uint8_t);
+    void (*write_port)(void*, uint8_t, uint8_t);
 } i8080_t;
 
+_Static_assert(sizeof(i8080_t) == 64, "i8080_t must fit in a single cache line");
+
 i8080_t* init_i8080(uint16_t initial_pc);
 void free_i8080(i8080_t* i8080);
-void decode_i8080(i8080_t* i8080);
+int decode_i8080(i8080_t* i8080);
+_Bool interrupt_i8080(i8080_t* i8080, uint8_t opcode);
 
 #endif // __I_8080_H__
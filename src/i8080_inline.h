@@ -0,0 +1,434 @@
+#ifndef __I_8080_INLINE_H__
+#define __I_8080_INLINE_H__
+
+#include <stdio.h>
+#include <stdbool.h>
+
+#include "i8080.h"
+#include "i8080_instr.h"
+
+// Header-only build of the core. Every function is static inline and goes through the
+// memory and port policy macros of i8080_instr.h, so an embedder that defines them (or
+// I8080_FLAT_MEMORY) before including this header gets the accesses inlined into its own
+// run loop instead of calling into libi8080 and through the callback pointers:
+//
+//     static uint8_t memory[0x10000];
+//     #define I8080_FLAT_MEMORY memory
+//     #include "i8080_inline.h"
+//
+// decode_i8080 and interrupt_i8080 in i8080.c are this header with the callback policy.
+// Everything defined here and in i8080_instr.h is prefixed with i8080/I8080 so it does
+// not clash with the embedder's own names.
+
+#ifdef DEBUG
+    #define I8080_DEBUG_PRINTF(...) printf(__VA_ARGS__)
+#else
+    #define I8080_DEBUG_PRINTF(...)
+#endif
+
+// Number of clock cycles taken by each opcode. Conditional calls and returns list the
+// cycles for the not taken case, taking them costs 6 more cycles. The undocumented 0xcb,
+// 0xd9 and 0xdd/0xed/0xfd run as JMP, RET and CALL and are charged the same.
+static const uint8_t I8080_OPCODE_CYCLES[0x100] = {
+//  0   1   2   3   4   5   6   7   8   9   a   b   c   d   e   f
+    4,  10, 7,  5,  5,  5,  7,  4,  4,  10, 7,  5,  5,  5,  7,  4,  // 0
+    4,  10, 7,  5,  5,  5,  7,  4,  4,  10, 7,  5,  5,  5,  7,  4,  // 1
+    4,  10, 16, 5,  5,  5,  7,  4,  4,  10, 16, 5,  5,  5,  7,  4,  // 2
+    4,  10, 13, 5,  10, 10, 10, 4,  4,  10, 13, 5,  5,  5,  7,  4,  // 3
+    5,  5,  5,  5,  5,  5,  7,  5,  5,  5,  5,  5,  5,  5,  7,  5,  // 4
+    5,  5,  5,  5,  5,  5,  7,  5,  5,  5,  5,  5,  5,  5,  7,  5,  // 5
+    5,  5,  5,  5,  5,  5,  7,  5,  5,  5,  5,  5,  5,  5,  7,  5,  // 6
+    7,  7,  7,  7,  7,  7,  7,  7,  5,  5,  5,  5,  5,  5,  7,  5,  // 7
+    4,  4,  4,  4,  4,  4,  7,  4,  4,  4,  4,  4,  4,  4,  7,  4,  // 8
+    4,  4,  4,  4,  4,  4,  7,  4,  4,  4,  4,  4,  4,  4,  7,  4,  // 9
+    4,  4,  4,  4,  4,  4,  7,  4,  4,  4,  4,  4,  4,  4,  7,  4,  // a
+    4,  4,  4,  4,  4,  4,  7,  4,  4,  4,  4,  4,  4,  4,  7,  4,  // b
+    5,  10, 10, 10, 11, 11, 7,  11, 5,  10, 10, 10, 11, 17, 7,  11, // c
+    5,  10, 10, 10, 11, 11, 7,  11, 5,  10, 10, 10, 11, 17, 7,  11, // d
+    5,  10, 10, 18, 11, 11, 7,  11, 5,  5,  10, 4,  11, 17, 7,  11, // e
+    5,  10, 10, 4,  11, 11, 7,  11, 5,  5,  10, 4,  11, 17, 7,  11  // f
+};
+
+static inline void print_state_i8080_inline(i8080_t* i8080);
+static inline int decode_i8080_inline(i8080_t* i8080);
+static inline long run_i8080_inline(i8080_t* i8080, long cycles);
+static inline bool interrupt_i8080_inline(i8080_t* i8080, uint8_t opcode);
+
+static inline int decode_i8080_inline(i8080_t* i8080) {
+    print_state_i8080_inline(i8080);
+
+    // EI only enables interrupts after the instruction that follows it, so a handler
+    // ending in EI; RET returns before the next interrupt can be accepted
+    if(i8080->interrupt_pending) {
+        i8080->interrupt_enabled = true;
+        i8080->interrupt_pending = false;
+    }
+
+    uint8_t opcode = I8080_READ_BYTE(i8080, i8080->pc++);
+    int cycles = I8080_OPCODE_CYCLES[opcode];
+
+    switch(opcode) {
+        case 0x00: I8080_DEBUG_PRINTF("NOP"); break;
+
+        // Carry Bit Instructions
+        case 0x37: I8080_DEBUG_PRINTF("STC"); i8080->f |= FLAG_CY; break;
+        case 0x3f: I8080_DEBUG_PRINTF("CMC"); i8080->f ^= FLAG_CY; break;
+
+        // Single Register Instructions
+        case 0x3c: I8080_DEBUG_PRINTF("INR A"); i8080->a = i8080_instr_inr(i8080, i8080->a); break;
+        case 0x04: I8080_DEBUG_PRINTF("INR B"); i8080->b = i8080_instr_inr(i8080, i8080->b); break;
+        case 0x0c: I8080_DEBUG_PRINTF("INR C"); i8080->c = i8080_instr_inr(i8080, i8080->c); break;
+        case 0x14: I8080_DEBUG_PRINTF("INR D"); i8080->d = i8080_instr_inr(i8080, i8080->d); break;
+        case 0x1c: I8080_DEBUG_PRINTF("INR E"); i8080->e = i8080_instr_inr(i8080, i8080->e); break;
+        case 0x24: I8080_DEBUG_PRINTF("INR H"); i8080->h = i8080_instr_inr(i8080, i8080->h); break;
+        case 0x2c: I8080_DEBUG_PRINTF("INR L"); i8080->l = i8080_instr_inr(i8080, i8080->l); break;
+        case 0x34: I8080_DEBUG_PRINTF("INR M"); I8080_WRITE_BYTE(i8080, i8080->hl, i8080_instr_inr(i8080, I8080_READ_BYTE(i8080, i8080->hl))); break;
+
+        case 0x3d: I8080_DEBUG_PRINTF("DCR A"); i8080->a = i8080_instr_dcr(i8080, i8080->a); break;
+        case 0x05: I8080_DEBUG_PRINTF("DCR B"); i8080->b = i8080_instr_dcr(i8080, i8080->b); break;
+        case 0x0d: I8080_DEBUG_PRINTF("DCR C"); i8080->c = i8080_instr_dcr(i8080, i8080->c); break;
+        case 0x15: I8080_DEBUG_PRINTF("DCR D"); i8080->d = i8080_instr_dcr(i8080, i8080->d); break;
+        case 0x1d: I8080_DEBUG_PRINTF("DCR E"); i8080->e = i8080_instr_dcr(i8080, i8080->e); break;
+        case 0x25: I8080_DEBUG_PRINTF("DCR H"); i8080->h = i8080_instr_dcr(i8080, i8080->h); break;
+        case 0x2d: I8080_DEBUG_PRINTF("DCR L"); i8080->l = i8080_instr_dcr(i8080, i8080->l); break;
+        case 0x35: I8080_DEBUG_PRINTF("DCR M"); I8080_WRITE_BYTE(i8080, i8080->hl, i8080_instr_dcr(i8080, I8080_READ_BYTE(i8080, i8080->hl))); break;
+
+        case 0x2f: I8080_DEBUG_PRINTF("CMA"); i8080->a ^= 0xff ; break;
+        case 0x27: I8080_DEBUG_PRINTF("DAA"); i8080_instr_daa(i8080); break;
+
+        // Data Transfer Instructions
+        case 0x7f: I8080_DEBUG_PRINTF("MOV A, A"); i8080->a = i8080->a; break;
+        case 0x78: I8080_DEBUG_PRINTF("MOV A, B"); i8080->a = i8080->b; break;
+        case 0x79: I8080_DEBUG_PRINTF("MOV A, C"); i8080->a = i8080->c; break;
+        case 0x7a: I8080_DEBUG_PRINTF("MOV A, D"); i8080->a = i8080->d; break;
+        case 0x7b: I8080_DEBUG_PRINTF("MOV A, E"); i8080->a = i8080->e; break;
+        case 0x7c: I8080_DEBUG_PRINTF("MOV A, H"); i8080->a = i8080->h; break;
+        case 0x7d: I8080_DEBUG_PRINTF("MOV A, L"); i8080->a = i8080->l; break;
+        case 0x7e: I8080_DEBUG_PRINTF("MOV A, M"); i8080->a = I8080_READ_BYTE(i8080, i8080->hl); break;
+
+        case 0x47: I8080_DEBUG_PRINTF("MOV B, A"); i8080->b = i8080->a; break;
+        case 0x40: I8080_DEBUG_PRINTF("MOV B, B"); i8080->b = i8080->b; break;
+        case 0x41: I8080_DEBUG_PRINTF("MOV B, C"); i8080->b = i8080->c; break;
+        case 0x42: I8080_DEBUG_PRINTF("MOV B, D"); i8080->b = i8080->d; break;
+        case 0x43: I8080_DEBUG_PRINTF("MOV B, E"); i8080->b = i8080->e; break;
+        case 0x44: I8080_DEBUG_PRINTF("MOV B, H"); i8080->b = i8080->h; break;
+        case 0x45: I8080_DEBUG_PRINTF("MOV B, L"); i8080->b = i8080->l; break;
+        case 0x46: I8080_DEBUG_PRINTF("MOV B, M"); i8080->b = I8080_READ_BYTE(i8080, i8080->hl); break;
+
+        case 0x4f: I8080_DEBUG_PRINTF("MOV C, A"); i8080->c = i8080->a; break;
+        case 0x48: I8080_DEBUG_PRINTF("MOV C, B"); i8080->c = i8080->b; break;
+        case 0x49: I8080_DEBUG_PRINTF("MOV C, C"); i8080->c = i8080->c; break;
+        case 0x4a: I8080_DEBUG_PRINTF("MOV C, D"); i8080->c = i8080->d; break;
+        case 0x4b: I8080_DEBUG_PRINTF("MOV C, E"); i8080->c = i8080->e; break;
+        case 0x4c: I8080_DEBUG_PRINTF("MOV C, H"); i8080->c = i8080->h; break;
+        case 0x4d: I8080_DEBUG_PRINTF("MOV C, L"); i8080->c = i8080->l; break;
+        case 0x4e: I8080_DEBUG_PRINTF("MOV C, M"); i8080->c = I8080_READ_BYTE(i8080, i8080->hl); break;
+
+        case 0x57: I8080_DEBUG_PRINTF("MOV D, A"); i8080->d = i8080->a; break;
+        case 0x50: I8080_DEBUG_PRINTF("MOV D, B"); i8080->d = i8080->b; break;
+        case 0x51: I8080_DEBUG_PRINTF("MOV D, C"); i8080->d = i8080->c; break;
+        case 0x52: I8080_DEBUG_PRINTF("MOV D, D"); i8080->d = i8080->d; break;
+        case 0x53: I8080_DEBUG_PRINTF("MOV D, E"); i8080->d = i8080->e; break;
+        case 0x54: I8080_DEBUG_PRINTF("MOV D, H"); i8080->d = i8080->h; break;
+        case 0x55: I8080_DEBUG_PRINTF("MOV D, L"); i8080->d = i8080->l; break;
+        case 0x56: I8080_DEBUG_PRINTF("MOV D, M"); i8080->d = I8080_READ_BYTE(i8080, i8080->hl); break;
+
+        case 0x5f: I8080_DEBUG_PRINTF("MOV E, A"); i8080->e = i8080->a; break;
+        case 0x58: I8080_DEBUG_PRINTF("MOV E, B"); i8080->e = i8080->b; break;
+        case 0x59: I8080_DEBUG_PRINTF("MOV E, C"); i8080->e = i8080->c; break;
+        case 0x5a: I8080_DEBUG_PRINTF("MOV E, D"); i8080->e = i8080->d; break;
+        case 0x5b: I8080_DEBUG_PRINTF("MOV E, E"); i8080->e = i8080->e; break;
+        case 0x5c: I8080_DEBUG_PRINTF("MOV E, H"); i8080->e = i8080->h; break;
+        case 0x5d: I8080_DEBUG_PRINTF("MOV E, L"); i8080->e = i8080->l; break;
+        case 0x5e: I8080_DEBUG_PRINTF("MOV E, M"); i8080->e = I8080_READ_BYTE(i8080, i8080->hl); break;
+
+        case 0x67: I8080_DEBUG_PRINTF("MOV H, A"); i8080->h = i8080->a; break;
+        case 0x60: I8080_DEBUG_PRINTF("MOV H, B"); i8080->h = i8080->b; break;
+        case 0x61: I8080_DEBUG_PRINTF("MOV H, C"); i8080->h = i8080->c; break;
+        case 0x62: I8080_DEBUG_PRINTF("MOV H, D"); i8080->h = i8080->d; break;
+        case 0x63: I8080_DEBUG_PRINTF("MOV H, E"); i8080->h = i8080->e; break;
+        case 0x64: I8080_DEBUG_PRINTF("MOV H, H"); i8080->h = i8080->h; break;
+        case 0x65: I8080_DEBUG_PRINTF("MOV H, L"); i8080->h = i8080->l; break;
+        case 0x66: I8080_DEBUG_PRINTF("MOV H, M"); i8080->h = I8080_READ_BYTE(i8080, i8080->hl); break;
+
+        case 0x6f: I8080_DEBUG_PRINTF("MOV L, A"); i8080->l = i8080->a; break;
+        case 0x68: I8080_DEBUG_PRINTF("MOV L, B"); i8080->l = i8080->b; break;
+        case 0x69: I8080_DEBUG_PRINTF("MOV L, C"); i8080->l = i8080->c; break;
+        case 0x6a: I8080_DEBUG_PRINTF("MOV L, D"); i8080->l = i8080->d; break;
+        case 0x6b: I8080_DEBUG_PRINTF("MOV L, E"); i8080->l = i8080->e; break;
+        case 0x6c: I8080_DEBUG_PRINTF("MOV L, H"); i8080->l = i8080->h; break;
+        case 0x6d: I8080_DEBUG_PRINTF("MOV L, L"); i8080->l = i8080->l; break;
+        case 0x6e: I8080_DEBUG_PRINTF("MOV L, M"); i8080->l = I8080_READ_BYTE(i8080, i8080->hl); break;
+
+        case 0x77: I8080_DEBUG_PRINTF("MOV M, A"); I8080_WRITE_BYTE(i8080, i8080->hl, i8080->a); break;
+        case 0x70: I8080_DEBUG_PRINTF("MOV M, B"); I8080_WRITE_BYTE(i8080, i8080->hl, i8080->b); break;
+        case 0x71: I8080_DEBUG_PRINTF("MOV M, C"); I8080_WRITE_BYTE(i8080, i8080->hl, i8080->c); break;
+        case 0x72: I8080_DEBUG_PRINTF("MOV M, D"); I8080_WRITE_BYTE(i8080, i8080->hl, i8080->d); break;
+        case 0x73: I8080_DEBUG_PRINTF("MOV M, E"); I8080_WRITE_BYTE(i8080, i8080->hl, i8080->e); break;
+        case 0x74: I8080_DEBUG_PRINTF("MOV M, H"); I8080_WRITE_BYTE(i8080, i8080->hl, i8080->h); break;
+        case 0x75: I8080_DEBUG_PRINTF("MOV M, L"); I8080_WRITE_BYTE(i8080, i8080->hl, i8080->l); break;
+
+        case 0x02: I8080_DEBUG_PRINTF("STAX B"); I8080_WRITE_BYTE(i8080, i8080->bc, i8080->a); break;
+        case 0x12: I8080_DEBUG_PRINTF("STAX D"); I8080_WRITE_BYTE(i8080, i8080->de, i8080->a); break;
+
+        case 0x0a: I8080_DEBUG_PRINTF("LDAX B"); i8080->a = I8080_READ_BYTE(i8080, i8080->bc); break;
+        case 0x1a: I8080_DEBUG_PRINTF("LDAX D"); i8080->a = I8080_READ_BYTE(i8080, i8080->de); break;
+
+        // Regiser or Memory to Accumulator Instructions
+        case 0x87: I8080_DEBUG_PRINTF("ADD A"); i8080->a = i8080_instr_add(i8080, i8080->a, false); break;
+        case 0x80: I8080_DEBUG_PRINTF("ADD B"); i8080->a = i8080_instr_add(i8080, i8080->b, false); break;
+        case 0x81: I8080_DEBUG_PRINTF("ADD C"); i8080->a = i8080_instr_add(i8080, i8080->c, false); break;
+        case 0x82: I8080_DEBUG_PRINTF("ADD D"); i8080->a = i8080_instr_add(i8080, i8080->d, false); break;
+        case 0x83: I8080_DEBUG_PRINTF("ADD E"); i8080->a = i8080_instr_add(i8080, i8080->e, false); break;
+        case 0x84: I8080_DEBUG_PRINTF("ADD H"); i8080->a = i8080_instr_add(i8080, i8080->h, false); break;
+        case 0x85: I8080_DEBUG_PRINTF("ADD L"); i8080->a = i8080_instr_add(i8080, i8080->l, false); break;
+        case 0x86: I8080_DEBUG_PRINTF("ADD M"); i8080->a = i8080_instr_add(i8080, I8080_READ_BYTE(i8080, i8080->hl), false); break;
+
+        case 0x8f: I8080_DEBUG_PRINTF("ADC A"); i8080->a = i8080_instr_add(i8080, i8080->a, (i8080->f & FLAG_CY)); break;
+        case 0x88: I8080_DEBUG_PRINTF("ADC B"); i8080->a = i8080_instr_add(i8080, i8080->b, (i8080->f & FLAG_CY)); break;
+        case 0x89: I8080_DEBUG_PRINTF("ADC C"); i8080->a = i8080_instr_add(i8080, i8080->c, (i8080->f & FLAG_CY)); break;
+        case 0x8a: I8080_DEBUG_PRINTF("ADC D"); i8080->a = i8080_instr_add(i8080, i8080->d, (i8080->f & FLAG_CY)); break;
+        case 0x8b: I8080_DEBUG_PRINTF("ADC E"); i8080->a = i8080_instr_add(i8080, i8080->e, (i8080->f & FLAG_CY)); break;
+        case 0x8c: I8080_DEBUG_PRINTF("ADC H"); i8080->a = i8080_instr_add(i8080, i8080->h, (i8080->f & FLAG_CY)); break;
+        case 0x8d: I8080_DEBUG_PRINTF("ADC L"); i8080->a = i8080_instr_add(i8080, i8080->l, (i8080->f & FLAG_CY)); break;
+        case 0x8e: I8080_DEBUG_PRINTF("ADC M"); i8080->a = i8080_instr_add(i8080, I8080_READ_BYTE(i8080, i8080->hl), (i8080->f & FLAG_CY)); break;
+
+        case 0x97: I8080_DEBUG_PRINTF("SUB A"); i8080->a = i8080_instr_sub(i8080, i8080->a, false); break;
+        case 0x90: I8080_DEBUG_PRINTF("SUB B"); i8080->a = i8080_instr_sub(i8080, i8080->b, false); break;
+        case 0x91: I8080_DEBUG_PRINTF("SUB C"); i8080->a = i8080_instr_sub(i8080, i8080->c, false); break;
+        case 0x92: I8080_DEBUG_PRINTF("SUB D"); i8080->a = i8080_instr_sub(i8080, i8080->d, false); break;
+        case 0x93: I8080_DEBUG_PRINTF("SUB E"); i8080->a = i8080_instr_sub(i8080, i8080->e, false); break;
+        case 0x94: I8080_DEBUG_PRINTF("SUB H"); i8080->a = i8080_instr_sub(i8080, i8080->h, false); break;
+        case 0x95: I8080_DEBUG_PRINTF("SUB L"); i8080->a = i8080_instr_sub(i8080, i8080->l, false); break;
+        case 0x96: I8080_DEBUG_PRINTF("SUB M"); i8080->a = i8080_instr_sub(i8080, I8080_READ_BYTE(i8080, i8080->hl), false); break;
+
+        case 0x9f: I8080_DEBUG_PRINTF("SBB A"); i8080->a = i8080_instr_sub(i8080, i8080->a, (i8080->f & FLAG_CY)); break;
+        case 0x98: I8080_DEBUG_PRINTF("SBB B"); i8080->a = i8080_instr_sub(i8080, i8080->b, (i8080->f & FLAG_CY)); break;
+        case 0x99: I8080_DEBUG_PRINTF("SBB C"); i8080->a = i8080_instr_sub(i8080, i8080->c, (i8080->f & FLAG_CY)); break;
+        case 0x9a: I8080_DEBUG_PRINTF("SBB D"); i8080->a = i8080_instr_sub(i8080, i8080->d, (i8080->f & FLAG_CY)); break;
+        case 0x9b: I8080_DEBUG_PRINTF("SBB E"); i8080->a = i8080_instr_sub(i8080, i8080->e, (i8080->f & FLAG_CY)); break;
+        case 0x9c: I8080_DEBUG_PRINTF("SBB H"); i8080->a = i8080_instr_sub(i8080, i8080->h, (i8080->f & FLAG_CY)); break;
+        case 0x9d: I8080_DEBUG_PRINTF("SBB L"); i8080->a = i8080_instr_sub(i8080, i8080->l, (i8080->f & FLAG_CY)); break;
+        case 0x9e: I8080_DEBUG_PRINTF("SBB M"); i8080->a = i8080_instr_sub(i8080, I8080_READ_BYTE(i8080, i8080->hl), (i8080->f & FLAG_CY)); break;
+
+        case 0xa7: I8080_DEBUG_PRINTF("ANA A"); i8080->a = i8080_instr_ana(i8080, i8080->a); break;
+        case 0xa0: I8080_DEBUG_PRINTF("ANA B"); i8080->a = i8080_instr_ana(i8080, i8080->b); break;
+        case 0xa1: I8080_DEBUG_PRINTF("ANA C"); i8080->a = i8080_instr_ana(i8080, i8080->c); break;
+        case 0xa2: I8080_DEBUG_PRINTF("ANA D"); i8080->a = i8080_instr_ana(i8080, i8080->d); break;
+        case 0xa3: I8080_DEBUG_PRINTF("ANA E"); i8080->a = i8080_instr_ana(i8080, i8080->e); break;
+        case 0xa4: I8080_DEBUG_PRINTF("ANA H"); i8080->a = i8080_instr_ana(i8080, i8080->h); break;
+        case 0xa5: I8080_DEBUG_PRINTF("ANA L"); i8080->a = i8080_instr_ana(i8080, i8080->l); break;
+        case 0xa6: I8080_DEBUG_PRINTF("ANA M"); i8080->a = i8080_instr_ana(i8080, I8080_READ_BYTE(i8080, i8080->hl)); break;
+
+        case 0xaf: I8080_DEBUG_PRINTF("XRA A"); i8080->a = i8080_instr_xra(i8080, i8080->a); break;
+        case 0xa8: I8080_DEBUG_PRINTF("XRA B"); i8080->a = i8080_instr_xra(i8080, i8080->b); break;
+        case 0xa9: I8080_DEBUG_PRINTF("XRA C"); i8080->a = i8080_instr_xra(i8080, i8080->c); break;
+        case 0xaa: I8080_DEBUG_PRINTF("XRA D"); i8080->a = i8080_instr_xra(i8080, i8080->d); break;
+        case 0xab: I8080_DEBUG_PRINTF("XRA E"); i8080->a = i8080_instr_xra(i8080, i8080->e); break;
+        case 0xac: I8080_DEBUG_PRINTF("XRA H"); i8080->a = i8080_instr_xra(i8080, i8080->h); break;
+        case 0xad: I8080_DEBUG_PRINTF("XRA L"); i8080->a = i8080_instr_xra(i8080, i8080->l); break;
+        case 0xae: I8080_DEBUG_PRINTF("XRA M"); i8080->a = i8080_instr_xra(i8080, I8080_READ_BYTE(i8080, i8080->hl)); break;
+
+        case 0xb7: I8080_DEBUG_PRINTF("ORA A"); i8080->a = i8080_instr_ora(i8080, i8080->a); break;
+        case 0xb0: I8080_DEBUG_PRINTF("ORA B"); i8080->a = i8080_instr_ora(i8080, i8080->b); break;
+        case 0xb1: I8080_DEBUG_PRINTF("ORA C"); i8080->a = i8080_instr_ora(i8080, i8080->c); break;
+        case 0xb2: I8080_DEBUG_PRINTF("ORA D"); i8080->a = i8080_instr_ora(i8080, i8080->d); break;
+        case 0xb3: I8080_DEBUG_PRINTF("ORA E"); i8080->a = i8080_instr_ora(i8080, i8080->e); break;
+        case 0xb4: I8080_DEBUG_PRINTF("ORA H"); i8080->a = i8080_instr_ora(i8080, i8080->h); break;
+        case 0xb5: I8080_DEBUG_PRINTF("ORA L"); i8080->a = i8080_instr_ora(i8080, i8080->l); break;
+        case 0xb6: I8080_DEBUG_PRINTF("ORA M"); i8080->a = i8080_instr_ora(i8080, I8080_READ_BYTE(i8080, i8080->hl)); break;
+
+        case 0xbf: I8080_DEBUG_PRINTF("CMP A"); i8080_instr_sub(i8080, i8080->a, false); break;
+        case 0xb8: I8080_DEBUG_PRINTF("CMP B"); i8080_instr_sub(i8080, i8080->b, false); break;
+        case 0xb9: I8080_DEBUG_PRINTF("CMP C"); i8080_instr_sub(i8080, i8080->c, false); break;
+        case 0xba: I8080_DEBUG_PRINTF("CMP D"); i8080_instr_sub(i8080, i8080->d, false); break;
+        case 0xbb: I8080_DEBUG_PRINTF("CMP E"); i8080_instr_sub(i8080, i8080->e, false); break;
+        case 0xbc: I8080_DEBUG_PRINTF("CMP H"); i8080_instr_sub(i8080, i8080->h, false); break;
+        case 0xbd: I8080_DEBUG_PRINTF("CMP L"); i8080_instr_sub(i8080, i8080->l, false); break;
+        case 0xbe: I8080_DEBUG_PRINTF("CMP M"); i8080_instr_sub(i8080, I8080_READ_BYTE(i8080, i8080->hl), false); break;
+
+        // Rotate Accumulator Instructions
+        case 0x07: I8080_DEBUG_PRINTF("RLC"); i8080_instr_rlc(i8080); break;
+        case 0x0f: I8080_DEBUG_PRINTF("RRC"); i8080_instr_rrc(i8080); break;
+        case 0x17: I8080_DEBUG_PRINTF("RAL"); i8080_instr_ral(i8080); break;
+        case 0x1f: I8080_DEBUG_PRINTF("RAR"); i8080_instr_rar(i8080); break;
+
+        // Register Pair Instructions
+        case 0xc5: I8080_DEBUG_PRINTF("PUSH B"); i8080_instr_push(i8080, i8080->bc); break;
+        case 0xd5: I8080_DEBUG_PRINTF("PUSH D"); i8080_instr_push(i8080, i8080->de); break;
+        case 0xe5: I8080_DEBUG_PRINTF("PUSH H"); i8080_instr_push(i8080, i8080->hl); break;
+        case 0xf5: I8080_DEBUG_PRINTF("PUSH PSW"); i8080_instr_push(i8080, i8080->af); break;
+
+        case 0xc1: I8080_DEBUG_PRINTF("POP B"); i8080->bc = i8080_instr_pop(i8080); break;
+        case 0xd1: I8080_DEBUG_PRINTF("POP D"); i8080->de = i8080_instr_pop(i8080); break;
+        case 0xe1: I8080_DEBUG_PRINTF("POP H"); i8080->hl = i8080_instr_pop(i8080); break;
+        case 0xf1: I8080_DEBUG_PRINTF("POP PSW"); i8080_instr_pop_psw(i8080); break;
+
+        case 0x09: I8080_DEBUG_PRINTF("DAD B"); i8080_instr_dad(i8080, i8080->bc); break;
+        case 0x19: I8080_DEBUG_PRINTF("DAD D"); i8080_instr_dad(i8080, i8080->de); break;
+        case 0x29: I8080_DEBUG_PRINTF("DAD H"); i8080_instr_dad(i8080, i8080->hl); break;
+        case 0x39: I8080_DEBUG_PRINTF("DAD SP"); i8080_instr_dad(i8080, i8080->sp); break;
+
+        case 0x03: I8080_DEBUG_PRINTF("INX B"); i8080->bc++; break;
+        case 0x13: I8080_DEBUG_PRINTF("INX D"); i8080->de++; break;
+        case 0x23: I8080_DEBUG_PRINTF("INX H"); i8080->hl++; break;
+        case 0x33: I8080_DEBUG_PRINTF("INX SP"); i8080->sp++; break;
+
+        case 0x0b: I8080_DEBUG_PRINTF("DCX B"); i8080->bc--; break;
+        case 0x1b: I8080_DEBUG_PRINTF("DCX D"); i8080->de--; break;
+        case 0x2b: I8080_DEBUG_PRINTF("DCX H"); i8080->hl--; break;
+        case 0x3b: I8080_DEBUG_PRINTF("DCX SP"); i8080->sp--; break;
+
+        case 0xeb: I8080_DEBUG_PRINTF("XCHG"); i8080_instr_xchg(i8080); break;
+        case 0xe3: I8080_DEBUG_PRINTF("XTHL"); i8080_instr_xthl(i8080); break;
+        case 0xf9: I8080_DEBUG_PRINTF("SPHL"); i8080->sp = i8080->hl; break;
+
+        // Immediate Instructions
+        case 0x01: I8080_DEBUG_PRINTF("LXI B, #0x%02x%02x", I8080_READ_BYTE(i8080, i8080->pc + 1), I8080_READ_BYTE(i8080, i8080->pc)); i8080->bc = i8080_instr_read_word(i8080); break;
+        case 0x11: I8080_DEBUG_PRINTF("LXI D, #0x%02x%02x", I8080_READ_BYTE(i8080, i8080->pc + 1), I8080_READ_BYTE(i8080, i8080->pc)); i8080->de = i8080_instr_read_word(i8080); break;
+        case 0x21: I8080_DEBUG_PRINTF("LXI H, #0x%02x%02x", I8080_READ_BYTE(i8080, i8080->pc + 1), I8080_READ_BYTE(i8080, i8080->pc)); i8080->hl = i8080_instr_read_word(i8080); break;
+        case 0x31: I8080_DEBUG_PRINTF("LXI SP, #0x%02x%02x", I8080_READ_BYTE(i8080, i8080->pc + 1), I8080_READ_BYTE(i8080, i8080->pc)); i8080->sp = i8080_instr_read_word(i8080); break;
+
+        case 0x3e: I8080_DEBUG_PRINTF("MVI A, #0x%02x", I8080_READ_BYTE(i8080, i8080->pc)); i8080->a = I8080_READ_BYTE(i8080, i8080->pc++); break;
+        case 0x06: I8080_DEBUG_PRINTF("MVI B, #0x%02x", I8080_READ_BYTE(i8080, i8080->pc)); i8080->b = I8080_READ_BYTE(i8080, i8080->pc++); break;
+        case 0x0e: I8080_DEBUG_PRINTF("MVI C, #0x%02x", I8080_READ_BYTE(i8080, i8080->pc)); i8080->c = I8080_READ_BYTE(i8080, i8080->pc++); break;
+        case 0x16: I8080_DEBUG_PRINTF("MVI D, #0x%02x", I8080_READ_BYTE(i8080, i8080->pc)); i8080->d = I8080_READ_BYTE(i8080, i8080->pc++); break;
+        case 0x1e: I8080_DEBUG_PRINTF("MVI E, #0x%02x", I8080_READ_BYTE(i8080, i8080->pc)); i8080->e = I8080_READ_BYTE(i8080, i8080->pc++); break;
+        case 0x26: I8080_DEBUG_PRINTF("MVI H, #0x%02x", I8080_READ_BYTE(i8080, i8080->pc)); i8080->h = I8080_READ_BYTE(i8080, i8080->pc++); break;
+        case 0x2e: I8080_DEBUG_PRINTF("MVI L, #0x%02x", I8080_READ_BYTE(i8080, i8080->pc)); i8080->l = I8080_READ_BYTE(i8080, i8080->pc++); break;
+        case 0x36: I8080_DEBUG_PRINTF("MVI M, #0x%02x", I8080_READ_BYTE(i8080, i8080->pc)); I8080_WRITE_BYTE(i8080, i8080->hl, I8080_READ_BYTE(i8080, i8080->pc++)); break;
+
+        case 0xc6: I8080_DEBUG_PRINTF("ADI #0x%02x", I8080_READ_BYTE(i8080, i8080->pc)); i8080->a = i8080_instr_add(i8080, I8080_READ_BYTE(i8080, i8080->pc++), false); break;
+        case 0xce: I8080_DEBUG_PRINTF("ACI #0x%02x", I8080_READ_BYTE(i8080, i8080->pc)); i8080->a = i8080_instr_add(i8080, I8080_READ_BYTE(i8080, i8080->pc++), (i8080->f & FLAG_CY)); break;
+        case 0xd6: I8080_DEBUG_PRINTF("SUI #0x%02x", I8080_READ_BYTE(i8080, i8080->pc)); i8080->a = i8080_instr_sub(i8080, I8080_READ_BYTE(i8080, i8080->pc++), false); break;
+        case 0xde: I8080_DEBUG_PRINTF("SBI #0x%02x", I8080_READ_BYTE(i8080, i8080->pc)); i8080->a = i8080_instr_sub(i8080, I8080_READ_BYTE(i8080, i8080->pc++), (i8080->f & FLAG_CY)); break;
+        case 0xe6: I8080_DEBUG_PRINTF("ANI #0x%02x", I8080_READ_BYTE(i8080, i8080->pc)); i8080->a = i8080_instr_ana(i8080, I8080_READ_BYTE(i8080, i8080->pc++)); break;
+        case 0xee: I8080_DEBUG_PRINTF("XRI #0x%02x", I8080_READ_BYTE(i8080, i8080->pc)); i8080->a = i8080_instr_xra(i8080, I8080_READ_BYTE(i8080, i8080->pc++)); break;
+        case 0xf6: I8080_DEBUG_PRINTF("ORI #0x%02x", I8080_READ_BYTE(i8080, i8080->pc)); i8080->a = i8080_instr_ora(i8080, I8080_READ_BYTE(i8080, i8080->pc++)); break;
+        case 0xfe: I8080_DEBUG_PRINTF("CPI #0x%02x", I8080_READ_BYTE(i8080, i8080->pc)); i8080_instr_sub(i8080, I8080_READ_BYTE(i8080, i8080->pc++), false); break;
+
+        // Direct Addressing Instructions
+        case 0x32: I8080_DEBUG_PRINTF("STA 0x%02x%02x", I8080_READ_BYTE(i8080, i8080->pc + 1), I8080_READ_BYTE(i8080, i8080->pc)); I8080_WRITE_BYTE(i8080, i8080_instr_read_word(i8080), i8080->a); break;
+        case 0x3a: I8080_DEBUG_PRINTF("LDA 0x%02x%02x", I8080_READ_BYTE(i8080, i8080->pc + 1), I8080_READ_BYTE(i8080, i8080->pc)); i8080->a = I8080_READ_BYTE(i8080, i8080_instr_read_word(i8080)); break;
+
+        case 0x22: I8080_DEBUG_PRINTF("SHLD 0x%02x%02x", I8080_READ_BYTE(i8080, i8080->pc + 1), I8080_READ_BYTE(i8080, i8080->pc)); i8080_instr_shld(i8080); break;
+        case 0x2a: I8080_DEBUG_PRINTF("LHLD 0x%02x%02x", I8080_READ_BYTE(i8080, i8080->pc + 1), I8080_READ_BYTE(i8080, i8080->pc)); i8080_instr_lhld(i8080); break;
+
+        // Jump Instructions
+        case 0xe9: I8080_DEBUG_PRINTF("PCHL"); i8080->pc = i8080->hl; break;
+        case 0xc3: I8080_DEBUG_PRINTF("JMP 0x%02x%02x", I8080_READ_BYTE(i8080, i8080->pc + 1), I8080_READ_BYTE(i8080, i8080->pc)); i8080_instr_jmp(i8080, i8080_instr_read_word(i8080), true); break;
+        case 0xda: I8080_DEBUG_PRINTF("JC 0x%02x%02x", I8080_READ_BYTE(i8080, i8080->pc + 1), I8080_READ_BYTE(i8080, i8080->pc)); i8080_instr_jmp(i8080, i8080_instr_read_word(i8080), (i8080->f & FLAG_CY)); break;
+        case 0xd2: I8080_DEBUG_PRINTF("JNC 0x%02x%02x", I8080_READ_BYTE(i8080, i8080->pc + 1), I8080_READ_BYTE(i8080, i8080->pc)); i8080_instr_jmp(i8080, i8080_instr_read_word(i8080), !(i8080->f & FLAG_CY)); break;
+        case 0xca: I8080_DEBUG_PRINTF("JZ 0x%02x%02x", I8080_READ_BYTE(i8080, i8080->pc + 1), I8080_READ_BYTE(i8080, i8080->pc)); i8080_instr_jmp(i8080, i8080_instr_read_word(i8080), (i8080->f & FLAG_Z)); break;
+        case 0xc2: I8080_DEBUG_PRINTF("JNZ 0x%02x%02x", I8080_READ_BYTE(i8080, i8080->pc + 1), I8080_READ_BYTE(i8080, i8080->pc)); i8080_instr_jmp(i8080, i8080_instr_read_word(i8080), !(i8080->f & FLAG_Z)); break;
+        case 0xfa: I8080_DEBUG_PRINTF("JM 0x%02x%02x", I8080_READ_BYTE(i8080, i8080->pc + 1), I8080_READ_BYTE(i8080, i8080->pc)); i8080_instr_jmp(i8080, i8080_instr_read_word(i8080), (i8080->f & FLAG_S)); break;
+        case 0xf2: I8080_DEBUG_PRINTF("JP 0x%02x%02x", I8080_READ_BYTE(i8080, i8080->pc + 1), I8080_READ_BYTE(i8080, i8080->pc)); i8080_instr_jmp(i8080, i8080_instr_read_word(i8080), !(i8080->f & FLAG_S)); break;
+        case 0xea: I8080_DEBUG_PRINTF("JPE 0x%02x%02x", I8080_READ_BYTE(i8080, i8080->pc + 1), I8080_READ_BYTE(i8080, i8080->pc)); i8080_instr_jmp(i8080, i8080_instr_read_word(i8080), (i8080->f & FLAG_P)); break;
+        case 0xe2: I8080_DEBUG_PRINTF("JPO 0x%02x%02x", I8080_READ_BYTE(i8080, i8080->pc + 1), I8080_READ_BYTE(i8080, i8080->pc)); i8080_instr_jmp(i8080, i8080_instr_read_word(i8080), !(i8080->f & FLAG_P)); break;
+
+        // Call Subroutine Instructions
+        case 0xcd: I8080_DEBUG_PRINTF("CALL 0x%02x%02x", I8080_READ_BYTE(i8080, i8080->pc + 1), I8080_READ_BYTE(i8080, i8080->pc)); i8080_instr_call(i8080, i8080_instr_read_word(i8080), true); break;
+        case 0xdc: I8080_DEBUG_PRINTF("CC 0x%02x%02x", I8080_READ_BYTE(i8080, i8080->pc + 1), I8080_READ_BYTE(i8080, i8080->pc)); cycles += i8080_instr_call(i8080, i8080_instr_read_word(i8080), (i8080->f & FLAG_CY)) ? 6 : 0; break;
+        case 0xd4: I8080_DEBUG_PRINTF("CNC 0x%02x%02x", I8080_READ_BYTE(i8080, i8080->pc + 1), I8080_READ_BYTE(i8080, i8080->pc)); cycles += i8080_instr_call(i8080, i8080_instr_read_word(i8080), !(i8080->f & FLAG_CY)) ? 6 : 0; break;
+        case 0xcc: I8080_DEBUG_PRINTF("CZ 0x%02x%02x", I8080_READ_BYTE(i8080, i8080->pc + 1), I8080_READ_BYTE(i8080, i8080->pc)); cycles += i8080_instr_call(i8080, i8080_instr_read_word(i8080), (i8080->f & FLAG_Z)) ? 6 : 0; break;
+        case 0xc4: I8080_DEBUG_PRINTF("CNZ 0x%02x%02x", I8080_READ_BYTE(i8080, i8080->pc + 1), I8080_READ_BYTE(i8080, i8080->pc)); cycles += i8080_instr_call(i8080, i8080_instr_read_word(i8080), !(i8080->f & FLAG_Z)) ? 6 : 0; break;
+        case 0xfc: I8080_DEBUG_PRINTF("CM 0x%02x%02x", I8080_READ_BYTE(i8080, i8080->pc + 1), I8080_READ_BYTE(i8080, i8080->pc)); cycles += i8080_instr_call(i8080, i8080_instr_read_word(i8080), (i8080->f & FLAG_S)) ? 6 : 0; break;
+        case 0xf4: I8080_DEBUG_PRINTF("CP 0x%02x%02x", I8080_READ_BYTE(i8080, i8080->pc + 1), I8080_READ_BYTE(i8080, i8080->pc)); cycles += i8080_instr_call(i8080, i8080_instr_read_word(i8080), !(i8080->f & FLAG_S)) ? 6 : 0; break;
+        case 0xec: I8080_DEBUG_PRINTF("CPE 0x%02x%02x", I8080_READ_BYTE(i8080, i8080->pc + 1), I8080_READ_BYTE(i8080, i8080->pc)); cycles += i8080_instr_call(i8080, i8080_instr_read_word(i8080), (i8080->f & FLAG_P)) ? 6 : 0; break;
+        case 0xe4: I8080_DEBUG_PRINTF("CPO 0x%02x%02x", I8080_READ_BYTE(i8080, i8080->pc + 1), I8080_READ_BYTE(i8080, i8080->pc)); cycles += i8080_instr_call(i8080, i8080_instr_read_word(i8080), !(i8080->f & FLAG_P)) ? 6 : 0; break;
+
+        // Return From Subroutine Instructions
+        case 0xc9: I8080_DEBUG_PRINTF("RET"); i8080_instr_ret(i8080, true); break;
+        case 0xd8: I8080_DEBUG_PRINTF("RC"); cycles += i8080_instr_ret(i8080, (i8080->f & FLAG_CY)) ? 6 : 0; break;
+        case 0xd0: I8080_DEBUG_PRINTF("RNC"); cycles += i8080_instr_ret(i8080, !(i8080->f & FLAG_CY)) ? 6 : 0; break;
+        case 0xc8: I8080_DEBUG_PRINTF("RZ"); cycles += i8080_instr_ret(i8080, (i8080->f & FLAG_Z)) ? 6 : 0; break;
+        case 0xc0: I8080_DEBUG_PRINTF("RNZ"); cycles += i8080_instr_ret(i8080, !(i8080->f & FLAG_Z)) ? 6 : 0; break;
+        case 0xf8: I8080_DEBUG_PRINTF("RM"); cycles += i8080_instr_ret(i8080, (i8080->f & FLAG_S)) ? 6 : 0; break;
+        case 0xf0: I8080_DEBUG_PRINTF("RP"); cycles += i8080_instr_ret(i8080, !(i8080->f & FLAG_S)) ? 6 : 0; break;
+        case 0xe8: I8080_DEBUG_PRINTF("RPE"); cycles += i8080_instr_ret(i8080, (i8080->f & FLAG_P)) ? 6 : 0; break;
+        case 0xe0: I8080_DEBUG_PRINTF("RPO"); cycles += i8080_instr_ret(i8080, !(i8080->f & FLAG_P)) ? 6 : 0; break;
+
+        // RST (Reset) Instructions
+        case 0xc7: I8080_DEBUG_PRINTF("RST 0"); i8080_instr_call(i8080, 0x0000, true); break;
+        case 0xcf: I8080_DEBUG_PRINTF("RST 1"); i8080_instr_call(i8080, 0x0008, true); break;
+        case 0xd7: I8080_DEBUG_PRINTF("RST 2"); i8080_instr_call(i8080, 0x0010, true); break;
+        case 0xdf: I8080_DEBUG_PRINTF("RST 3"); i8080_instr_call(i8080, 0x0018, true); break;
+        case 0xe7: I8080_DEBUG_PRINTF("RST 4"); i8080_instr_call(i8080, 0x0020, true); break;
+        case 0xef: I8080_DEBUG_PRINTF("RST 5"); i8080_instr_call(i8080, 0x0028, true); break;
+        case 0xf7: I8080_DEBUG_PRINTF("RST 6"); i8080_instr_call(i8080, 0x0030, true); break;
+        case 0xff: I8080_DEBUG_PRINTF("RST 7"); i8080_instr_call(i8080, 0x0038, true); break;
+
+        // Interrupt Flip-Flop Instructions
+        case 0xfb: I8080_DEBUG_PRINTF("EI"); i8080->interrupt_pending = true; break;
+        case 0xf3: I8080_DEBUG_PRINTF("DI"); i8080->interrupt_enabled = false; i8080->interrupt_pending = false; break;
+
+        // Input/Output Instructions
+        case 0xdb: I8080_DEBUG_PRINTF("IN #0x%02x", I8080_READ_BYTE(i8080, i8080->pc)); i8080_instr_in(i8080, I8080_READ_BYTE(i8080, i8080->pc++)); break;
+        case 0xd3: I8080_DEBUG_PRINTF("OUT #0x%02x", I8080_READ_BYTE(i8080, i8080->pc)); i8080_instr_out(i8080, I8080_READ_BYTE(i8080, i8080->pc++)); break;
+
+        // HLT (Halt) Instructions
+        case 0x76: I8080_DEBUG_PRINTF("HLT"); i8080->pc--; i8080->halted = true; break;
+
+        // Other Instructions
+        case 0x08: I8080_DEBUG_PRINTF("-"); break;
+        case 0x10: I8080_DEBUG_PRINTF("-"); break;
+        case 0x18: I8080_DEBUG_PRINTF("-"); break;
+        case 0x20: I8080_DEBUG_PRINTF("-"); break;
+        case 0x28: I8080_DEBUG_PRINTF("-"); break;
+        case 0x30: I8080_DEBUG_PRINTF("-"); break;
+        case 0x38: I8080_DEBUG_PRINTF("-"); break;
+        case 0xcb: I8080_DEBUG_PRINTF("-"); i8080_instr_jmp(i8080, i8080_instr_read_word(i8080), true); break;
+        case 0xd9: I8080_DEBUG_PRINTF("-"); i8080_instr_ret(i8080, true); break;
+        case 0xdd: I8080_DEBUG_PRINTF("-"); i8080_instr_call(i8080, i8080_instr_read_word(i8080), true); break;
+        case 0xed: I8080_DEBUG_PRINTF("-"); i8080_instr_call(i8080, i8080_instr_read_word(i8080), true); break;
+        case 0xfd: I8080_DEBUG_PRINTF("-"); i8080_instr_call(i8080, i8080_instr_read_word(i8080), true); break;
+    }
+
+    I8080_DEBUG_PRINTF("\n----------------------------------------------------------------------\n");
+    return cycles;
+}
+
+static inline long run_i8080_inline(i8080_t* i8080, long cycles) {
+    // runs until at least the given number of cycles has passed and returns the cycles
+    // executed, the loop lives in the embedder's code so the registers can stay in host
+    // registers between instructions
+    long executed_cycles = 0;
+    while(executed_cycles < cycles) {
+        executed_cycles += decode_i8080_inline(i8080);
+    }
+    return executed_cycles;
+}
+
+static inline bool interrupt_i8080_inline(i8080_t* i8080, uint8_t opcode) {
+    // the interrupting device supplies a single instruction, which must be an RST and is
+    // only accepted while interrupts are enabled. Accepting it disables interrupts.
+    if(!i8080->interrupt_enabled || (opcode & 0xc7) != 0xc7) {
+        return false;
+    }
+
+    I8080_DEBUG_PRINTF("INTERRUPT RST %d\n", (opcode & 0x38) >> 3);
+    i8080->interrupt_enabled = false;
+
+    // resume after the HLT instruction once the interrupt routine returns
+    if(i8080->halted) {
+        i8080->pc++;
+        i8080->halted = false;
+    }
+
+    i8080_instr_call(i8080, opcode & 0x38, true);
+    return true;
+}
+
+static inline void print_state_i8080_inline(i8080_t* i8080) {
+    // print the current state of the i8080 object with the below format:
+    //
+    // PC - SP - A - B - C - D - E - H - L - Flags
+    // Opcode Mnemonic
+    I8080_DEBUG_PRINTF("pc      sp      a     b     c     d     e     h     l    | s z ac p cy\n");
+    I8080_DEBUG_PRINTF("0x%04x  0x%04x  0x%02x  0x%02x  0x%02x  0x%02x  0x%02x  0x%02x  0x%02x | %d %d %d  %d %d\n",
+                    i8080->pc, i8080->sp, i8080->a, i8080->b, i8080->c, i8080->d, i8080->e, i8080->h, i8080->l,
+                    (i8080->f & FLAG_S) != 0, (i8080->f & FLAG_Z) != 0, (i8080->f & FLAG_AC) != 0,
+                    (i8080->f & FLAG_P) != 0, (i8080->f & FLAG_CY) != 0);
+}
+
+#endif // __I_8080_INLINE_H__
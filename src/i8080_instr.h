@@ -0,0 +1,295 @@
+#ifndef __I_8080_INSTR_H__
+#define __I_8080_INSTR_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "i8080.h"
+
+// Flag and instruction semantics shared by the interpreter in i8080_inline.h and by
+// the C code that the recompiler generates, so both behave identically.
+
+// Memory and port access policy. By default every access goes through the callbacks in
+// i8080_t. An embedder can define these macros before including this header (or
+// i8080_inline.h) to have its accesses inlined instead; the policy applies to the whole
+// translation unit. Defining I8080_FLAT_MEMORY as a 64KB byte array or pointer is the
+// shortcut for hosts with flat RAM and no memory mapped devices.
+//
+// A flat memory write never reaches write_byte, so whatever the embedder's write_byte
+// would notify (video_notify_write, translation_notify_write) has to be called from
+// I8080_ON_WRITE instead. It runs before the byte is stored, so memory still holds
+// the old value, e.g.
+//
+//     #define I8080_ON_WRITE(i8080, address, byte) video_notify_write(video, (address))
+#if defined(I8080_FLAT_MEMORY) && !defined(I8080_READ_BYTE)
+    #ifndef I8080_ON_WRITE
+        #define I8080_ON_WRITE(i8080, address, byte) ((void)0)
+    #endif
+
+    // a function rather than a macro so the address, e.g. --i8080->sp, is evaluated once
+    static inline void i8080_flat_write_byte(i8080_t* i8080, uint16_t address, uint8_t byte) {
+        I8080_ON_WRITE(i8080, address, byte);
+        (I8080_FLAT_MEMORY)[address] = byte;
+    }
+
+    #define I8080_READ_BYTE(i8080, address) ((I8080_FLAT_MEMORY)[(uint16_t)(address)])
+    #define I8080_WRITE_BYTE(i8080, address, byte) i8080_flat_write_byte((i8080), (address), (byte))
+#endif
+
+#ifndef I8080_READ_BYTE
+    #define I8080_READ_BYTE(i8080, address) ((i8080)->read_byte(address))
+#endif
+#ifndef I8080_WRITE_BYTE
+    #define I8080_WRITE_BYTE(i8080, address, byte) ((i8080)->write_byte((address), (byte)))
+#endif
+
+// without a port handler IN leaves the accumulator unchanged and OUT is ignored
+#ifndef I8080_READ_PORT
+    #define I8080_READ_PORT(i8080, port) \
+        ((i8080)->read_port != NULL ? (i8080)->read_port((i8080)->io_context, (port)) : (i8080)->a)
+#endif
+#ifndef I8080_WRITE_PORT
+    #define I8080_WRITE_PORT(i8080, port, byte) \
+        ((i8080)->write_port != NULL ? (i8080)->write_port((i8080)->io_context, (port), (byte)) : (void)0)
+#endif
+
+// Sign, zero and parity flags for every possible result byte, built at compile time:
+// if the number of 1s is even, parity is set, if it is odd, parity is not set
+#define I8080_PARITY(byte) ((((byte) ^ ((byte) >> 1) ^ ((byte) >> 2) ^ ((byte) >> 3) ^ \
+                              ((byte) >> 4) ^ ((byte) >> 5) ^ ((byte) >> 6) ^ ((byte) >> 7)) & 1) ? 0 : FLAG_P)
+#define I8080_SZP(byte) (((byte) & FLAG_S) | ((byte) == 0 ? FLAG_Z : 0) | I8080_PARITY(byte))
+#define I8080_SZP_4(byte) I8080_SZP(byte), I8080_SZP((byte) + 1), I8080_SZP((byte) + 2), I8080_SZP((byte) + 3)
+#define I8080_SZP_16(byte) I8080_SZP_4(byte), I8080_SZP_4((byte) + 4), I8080_SZP_4((byte) + 8), I8080_SZP_4((byte) + 12)
+#define I8080_SZP_64(byte) I8080_SZP_16(byte), I8080_SZP_16((byte) + 16), I8080_SZP_16((byte) + 32), I8080_SZP_16((byte) + 48)
+
+static const uint8_t I8080_SZP_TABLE[0x100] = {
+    I8080_SZP_64(0x00), I8080_SZP_64(0x40), I8080_SZP_64(0x80), I8080_SZP_64(0xc0)
+};
+
+// Register Getter/Setter Functions
+static inline uint16_t i8080_instr_read_word(i8080_t* i8080);
+static inline void i8080_instr_set_flag(i8080_t* i8080, uint8_t flag, bool value);
+
+// Instruction Function
+static inline uint8_t i8080_instr_inr(i8080_t* i8080, uint8_t register_value);
+static inline uint8_t i8080_instr_dcr(i8080_t* i8080, uint8_t register_value);
+static inline void i8080_instr_daa(i8080_t* i8080);
+static inline uint8_t i8080_instr_add(i8080_t* i8080, uint8_t register_value, bool include_carry);
+static inline uint8_t i8080_instr_sub(i8080_t* i8080, uint8_t register_value, bool include_carry);
+static inline uint8_t i8080_instr_ana(i8080_t* i8080, uint8_t register_value);
+static inline uint8_t i8080_instr_xra(i8080_t* i8080, uint8_t register_value);
+static inline uint8_t i8080_instr_ora(i8080_t* i8080, uint8_t register_value);
+static inline void i8080_instr_rlc(i8080_t* i8080);
+static inline void i8080_instr_rrc(i8080_t* i8080);
+static inline void i8080_instr_ral(i8080_t* i8080);
+static inline void i8080_instr_rar(i8080_t* i8080);
+static inline void i8080_instr_push(i8080_t* i8080, uint16_t register_value);
+static inline uint16_t i8080_instr_pop(i8080_t* i8080);
+static inline void i8080_instr_pop_psw(i8080_t* i8080);
+static inline void i8080_instr_dad(i8080_t* i8080, uint16_t register_pair);
+static inline void i8080_instr_xchg(i8080_t* i8080);
+static inline void i8080_instr_xthl(i8080_t* i8080);
+static inline void i8080_instr_shld(i8080_t* i8080);
+static inline void i8080_instr_lhld(i8080_t* i8080);
+static inline void i8080_instr_jmp(i8080_t* i8080, uint16_t address, bool condition);
+static inline bool i8080_instr_call(i8080_t* i8080, uint16_t address, bool condition);
+static inline bool i8080_instr_ret(i8080_t* i8080, bool condition);
+static inline void i8080_instr_in(i8080_t* i8080, uint8_t port);
+static inline void i8080_instr_out(i8080_t* i8080, uint8_t port);
+
+// Register Getter/Setter Functions
+static inline uint16_t i8080_instr_read_word(i8080_t* i8080) {
+    uint16_t word = I8080_READ_BYTE(i8080, i8080->pc++);
+    word = (I8080_READ_BYTE(i8080, i8080->pc++) << 8) | word;
+    return word;
+}
+
+static inline void i8080_instr_set_flag(i8080_t* i8080, uint8_t flag, bool value) {
+    i8080->f = value ? (i8080->f | flag) : (i8080->f & ~flag);
+}
+
+// Instruction Function
+static inline uint8_t i8080_instr_inr(i8080_t* i8080, uint8_t register_value) {
+    uint8_t result = register_value + 1;
+    // carry is not affected
+    i8080->f = (i8080->f & FLAG_CY) | FLAGS_FIXED_SET | I8080_SZP_TABLE[result] | ((result & 0x0f) == 0 ? FLAG_AC : 0);
+    return result;
+}
+
+static inline uint8_t i8080_instr_dcr(i8080_t* i8080, uint8_t register_value) {
+    uint8_t result = register_value - 1;
+    // carry is not affected
+    i8080->f = (i8080->f & FLAG_CY) | FLAGS_FIXED_SET | I8080_SZP_TABLE[result] | ((result & 0x0f) != 0x0f ? FLAG_AC : 0);
+    return result;
+}
+
+static inline void i8080_instr_daa(i8080_t* i8080) {
+    // Step 1:
+    // If lower 4-bit of accumulator is greater than 0x09 or auxiliary carry is set
+    // add 0x06 to the lower 4-bit number. Auxiliary carry is affected by this step.
+    // Step 2:
+    // If upper 4-bit of the resulting accumulator is greater than 0x09 or carry is set
+    // add 0x06 to the upper 4-bit number. Carry is affected by the step.
+    // 
+    // The carry and auxiliary carry flags are affected by the upper and lower 4-bits
+    // operations repsectivley, so is like a normal addition to the accumulator by the
+    // number to add (either 0x00, 0x06, 0x60 or 0x66) and the flags will be affected
+    // like any add instruction.
+    
+    uint8_t add_value = 0x00;
+    uint8_t lower_nibble = i8080->a & 0x0f;
+    if(lower_nibble > 0x09 || (i8080->f & FLAG_AC)) {
+        add_value += 0x06;
+    }
+
+    uint8_t upper_nibble = ((i8080->a + add_value) & 0xf0) >> 4;
+    if(upper_nibble > 0x09 || (i8080->f & FLAG_CY)) {
+        add_value += 0x60;
+    }
+
+    i8080->a = i8080_instr_add(i8080, add_value, false);
+}
+
+static inline uint8_t i8080_instr_add(i8080_t* i8080, uint8_t register_value, bool include_carry) {
+    uint16_t result = i8080->a + register_value + include_carry;
+    uint8_t aux_byte = (i8080->a & 0x0f) + (register_value & 0x0f) + include_carry;
+
+    i8080->f = FLAGS_FIXED_SET | I8080_SZP_TABLE[result & 0xff] |
+               ((result & 0x0100) != 0 ? FLAG_CY : 0) |
+               ((aux_byte & 0x10) != 0 ? FLAG_AC : 0);
+
+    return result & 0xff;
+}
+
+static inline uint8_t i8080_instr_sub(i8080_t* i8080, uint8_t register_value, bool include_carry) {
+    uint16_t result = i8080->a - register_value - include_carry;
+
+    // uint8_t aux_byte = (i8080->a & 0x0f) - (register_value & 0x0f) - include_carry;
+    // i8080->ac = (aux_byte & 0x10) != 0;
+
+    i8080->f = FLAGS_FIXED_SET | I8080_SZP_TABLE[result & 0xff] |
+               ((result & 0x0100) != 0 ? FLAG_CY : 0) |
+               ((~(i8080->a ^ result ^ register_value) & 0x10) != 0 ? FLAG_AC : 0);
+
+    return result & 0xff;
+}
+
+static inline uint8_t i8080_instr_ana(i8080_t* i8080, uint8_t register_value) {
+    uint8_t result = i8080->a & register_value;
+    // carry and auxiliary carry are cleared
+    i8080->f = FLAGS_FIXED_SET | I8080_SZP_TABLE[result]; // ((c->a | val) & 0x08) != 0; ??????
+    return result;
+}
+
+static inline uint8_t i8080_instr_xra(i8080_t* i8080, uint8_t register_value) {
+    uint8_t result = i8080->a ^ register_value;
+    // carry and auxiliary carry are cleared
+    i8080->f = FLAGS_FIXED_SET | I8080_SZP_TABLE[result];
+    return result;
+}
+
+static inline uint8_t i8080_instr_ora(i8080_t* i8080, uint8_t register_value) {
+    uint8_t result = i8080->a | register_value;
+    // carry and auxiliary carry are cleared
+    i8080->f = FLAGS_FIXED_SET | I8080_SZP_TABLE[result];
+    return result;
+}
+
+static inline void i8080_instr_rlc(i8080_t* i8080) {
+    i8080_instr_set_flag(i8080, FLAG_CY, (i8080->a & 0x80) != 0);
+    i8080->a = (i8080->a << 1) | (i8080->a >> 7);
+}
+
+static inline void i8080_instr_rrc(i8080_t* i8080) {
+    i8080_instr_set_flag(i8080, FLAG_CY, (i8080->a & 0x01) != 0);
+    i8080->a = (i8080->a >> 1) | (i8080->a << 7);
+}
+
+static inline void i8080_instr_ral(i8080_t* i8080) {
+    bool new_cy = (i8080->a & 0x80) != 0;
+    i8080->a = (i8080->a << 1) | (i8080->f & FLAG_CY);
+    i8080_instr_set_flag(i8080, FLAG_CY, new_cy);
+}
+
+static inline void i8080_instr_rar(i8080_t* i8080) {
+    bool new_cy = (i8080->a & 0x01) != 0;
+    i8080->a = (i8080->a >> 1) | ((i8080->f & FLAG_CY) << 7);
+    i8080_instr_set_flag(i8080, FLAG_CY, new_cy);
+}
+
+static inline void i8080_instr_push(i8080_t* i8080, uint16_t register_value) {
+    I8080_WRITE_BYTE(i8080, --i8080->sp, (register_value & 0xff00) >> 8);
+    I8080_WRITE_BYTE(i8080, --i8080->sp, register_value & 0x00ff);
+}
+
+static inline uint16_t i8080_instr_pop(i8080_t* i8080) {
+    uint16_t address = I8080_READ_BYTE(i8080, i8080->sp++);
+    address = (I8080_READ_BYTE(i8080, i8080->sp++) << 8) | address;
+    return address;
+}
+
+static inline void i8080_instr_pop_psw(i8080_t* i8080) {
+    // bits 5, 3 and 1 of the flags byte cannot be changed by popping
+    i8080->af = (i8080_instr_pop(i8080) & (0xff00 | FLAGS_FIXED_MASK)) | FLAGS_FIXED_SET;
+}
+
+static inline void i8080_instr_dad(i8080_t* i8080, uint16_t register_pair) {
+    unsigned int result = i8080->hl + register_pair;
+    i8080_instr_set_flag(i8080, FLAG_CY, (result & 0x00010000) != 0);
+    i8080->hl = result & 0xffff;
+}
+
+static inline void i8080_instr_xchg(i8080_t* i8080) {
+    uint16_t temp_hl = i8080->hl;
+    i8080->hl = i8080->de;
+    i8080->de = temp_hl;
+}
+
+static inline void i8080_instr_xthl(i8080_t* i8080) {
+    uint16_t temp_sp = i8080_instr_pop(i8080);
+    i8080_instr_push(i8080, i8080->hl);
+    i8080->hl = temp_sp;
+}
+
+static inline void i8080_instr_shld(i8080_t* i8080) {
+    uint16_t address = i8080_instr_read_word(i8080);
+    I8080_WRITE_BYTE(i8080, address, i8080->l);
+    I8080_WRITE_BYTE(i8080, address + 1, i8080->h);
+}
+
+static inline void i8080_instr_lhld(i8080_t* i8080) {
+    uint16_t address = i8080_instr_read_word(i8080);
+    i8080->l = I8080_READ_BYTE(i8080, address);
+    i8080->h = I8080_READ_BYTE(i8080, address + 1);
+}
+
+static inline void i8080_instr_jmp(i8080_t* i8080, uint16_t address, bool condition) {
+    if(condition) {
+        i8080->pc = address;
+    }
+}
+
+static inline bool i8080_instr_call(i8080_t* i8080, uint16_t address, bool condition) {
+    if(condition) {
+        i8080_instr_push(i8080, i8080->pc);
+        i8080_instr_jmp(i8080, address, true);
+    }
+    return condition;
+}
+
+static inline bool i8080_instr_ret(i8080_t* i8080, bool condition) {
+    if(condition) {
+        i8080->pc = i8080_instr_pop(i8080);
+    }
+    return condition;
+}
+
+static inline void i8080_instr_in(i8080_t* i8080, uint8_t port) {
+    i8080->a = I8080_READ_PORT(i8080, port);
+}
+
+static inline void i8080_instr_out(i8080_t* i8080, uint8_t port) {
+    I8080_WRITE_PORT(i8080, port, i8080->a);
+}
+
+#endif // __I_8080_INSTR_H__
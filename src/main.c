@@ -1,24 +1,63 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <string.h>
+#include <math.h>
 #include <time.h>
 
 #include "i8080.h"
+#include "pacer.h"
 
 static const char* TIME_FORMAT = "%d-%m-%Y %H:%M:%S";
 static const int MEMORY_SIZE = 0x10000;
 static uint8_t* memory;
+static double clock_speed = 0; // Hz, 0 runs flat out
+static double turbo = 1.0;
 
 static uint8_t read_byte(uint16_t address);
 static void write_byte(uint16_t address, uint8_t byte);
+static bool parse_positive(const char* text, double* value);
 static bool write_rom_into_memory(const char* rom_filename, int offset);
 static bool run_test_rom(const char* rom_filename, int offset);
 
 int main(int argc, char* argv[]) {
-    // run_test_rom("tests/TST8080.COM", 0x0100);
-    run_test_rom("tests/CPUTEST.COM", 0x0100);
-    // run_test_rom("tests/8080PRE.COM", 0x0100);
-    // run_test_rom("tests/8080EXM.COM", 0x0100);
+    // run every rom given on the command line, e.g. tests/TST8080.COM, tests/CPUTEST.COM,
+    // tests/8080PRE.COM or tests/8080EXM.COM, or the cpu test rom if none is given.
+    // --clock=<hz> paces execution to real time at that clock speed (2000000 for a 2 MHz 8080)
+    // and --turbo=<multiplier> runs the paced clock faster or slower.
+    int rom_count = 0;
+    for(int i = 1; i < argc; ++i) {
+        if(strncmp(argv[i], "--clock=", 8) == 0) {
+            if(!parse_positive(argv[i] + 8, &clock_speed)) {
+                printf("Error invalid clock speed '%s', expected a frequency in Hz.\n", argv[i] + 8);
+                printf("Usage: %s [--clock=<hz>] [--turbo=<multiplier>] [roms...]\n", argv[0]);
+                return 1;
+            }
+        } else if(strncmp(argv[i], "--turbo=", 8) == 0) {
+            if(!parse_positive(argv[i] + 8, &turbo)) {
+                printf("Error invalid turbo multiplier '%s'.\n", argv[i] + 8);
+                printf("Usage: %s [--clock=<hz>] [--turbo=<multiplier>] [roms...]\n", argv[0]);
+                return 1;
+            }
+        } else if(strncmp(argv[i], "--", 2) == 0) {
+            printf("Error unknown option '%s'.\n", argv[i]);
+            printf("Usage: %s [--clock=<hz>] [--turbo=<multiplier>] [roms...]\n", argv[0]);
+            return 1;
+        } else {
+            rom_count++;
+        }
+    }
+
+    if(rom_count == 0) {
+        run_test_rom("tests/CPUTEST.COM", 0x0100);
+        return 0;
+    }
+
+    for(int i = 1; i < argc; ++i) {
+        if(strncmp(argv[i], "--", 2) != 0) {
+            run_test_rom(argv[i], 0x0100);
+        }
+    }
     return 0;
 }
 
@@ -30,6 +69,18 @@ void write_byte(uint16_t address, uint8_t byte) {
     memory[address] = byte;
 }
 
+bool parse_positive(const char* text, double* value) {
+    // the whole text has to be a number greater than zero, e.g. "2MHz" or "0" are rejected
+    char* end;
+    double parsed = strtod(text, &end);
+    if(end == text || *end != '\0' || !(parsed > 0) || !isfinite(parsed)) {
+        return false;
+    }
+
+    *value = parsed;
+    return true;
+}
+
 bool write_rom_into_memory(const char* rom_filename, int offset) {
     // assume memory has been allocated
     FILE* fp = fopen(rom_filename, "rb");
@@ -79,6 +130,16 @@ bool run_test_rom(const char* rom_filename, int offset) {
 
         i8080->write_byte(0x0005, 0xc9);
 
+        pacer_t* pacer = NULL;
+        long slice_budget = 0, slice_cycles = 0;
+        if(clock_speed > 0) {
+            pacer = init_pacer(clock_speed);
+            if(pacer != NULL) {
+                pacer_set_turbo(pacer, turbo);
+                slice_budget = pacer_slice_budget(pacer);
+            }
+        }
+
         uint16_t current_pc, string_address;
         while(true) {
             current_pc = i8080->pc;
@@ -103,12 +164,26 @@ bool run_test_rom(const char* rom_filename, int offset) {
 
             }
 
-            decode_i8080(i8080);
+            slice_cycles += decode_i8080(i8080);
 
             if(i8080->pc == 0x0000) {
                 printf("\nJumped to 0x0000 from 0x%04x\n", current_pc);
                 break;
             }
+
+            // sleep until the end of the time slice once its cycles have been executed
+            if(pacer != NULL && slice_cycles >= slice_budget) {
+                fflush(stdout);
+                pacer_end_slice(pacer, slice_cycles);
+                slice_cycles = 0;
+                slice_budget = pacer_slice_budget(pacer);
+            }
+        }
+
+        if(pacer != NULL) {
+            pacer_end_slice(pacer, slice_cycles);
+            pacer_print_metrics(pacer);
+            free_pacer(pacer);
         }
 
         free_i8080(i8080);
@@ -0,0 +1,127 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <errno.h>
+
+#include "pacer.h"
+
+static const long NANOSECONDS_PER_SECOND = 1000000000L;
+static const long DEFAULT_SLICE_NS = 1000000L;
+static const int DEFAULT_MAX_LAG_SLICES = 100;
+
+static void add_nanoseconds(struct timespec* time, long nanoseconds);
+static long long difference_ns(const struct timespec* end, const struct timespec* start);
+
+pacer_t* init_pacer(double clock_hz) {
+    if(clock_hz <= 0) {
+        printf("Error invalid clock speed %.0lf Hz\n", clock_hz);
+        return NULL;
+    }
+
+    pacer_t* pacer = calloc(1, sizeof(pacer_t));
+    if(pacer == NULL) {
+        return NULL;
+    }
+
+    pacer->clock_hz = clock_hz;
+    pacer->slice_ns = DEFAULT_SLICE_NS;
+    pacer->max_lag_slices = DEFAULT_MAX_LAG_SLICES;
+    pacer_set_turbo(pacer, 1.0);
+
+    clock_gettime(CLOCK_MONOTONIC, &pacer->start_time);
+    pacer->deadline = pacer->start_time;
+    add_nanoseconds(&pacer->deadline, pacer->slice_ns);
+    return pacer;
+}
+
+void free_pacer(pacer_t* pacer) {
+    if(pacer == NULL) {
+        return;
+    }
+
+    free(pacer);
+}
+
+void pacer_set_turbo(pacer_t* pacer, double turbo) {
+    if(turbo <= 0) {
+        return;
+    }
+
+    pacer->turbo = turbo;
+    pacer->cycles_per_slice = pacer->clock_hz * turbo * pacer->slice_ns / NANOSECONDS_PER_SECOND;
+}
+
+long pacer_slice_budget(pacer_t* pacer) {
+    // the credit carries the fraction of a cycle and the overshoot of the last
+    // instruction of the previous slice, so the long run average is exact
+    pacer->cycle_credit += pacer->cycles_per_slice;
+    return pacer->cycle_credit > 0 ? (long)pacer->cycle_credit : 0;
+}
+
+void pacer_end_slice(pacer_t* pacer, long executed_cycles) {
+    pacer->cycle_credit -= executed_cycles;
+    pacer->total_cycles += executed_cycles;
+    pacer->slices++;
+
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    long long late_ns = difference_ns(&now, &pacer->deadline);
+
+    if(late_ns > 0) {
+        pacer->overruns++;
+        pacer->total_overrun_ns += late_ns;
+        if(late_ns > pacer->max_overrun_ns) {
+            pacer->max_overrun_ns = late_ns;
+        }
+
+        if(late_ns > (long long)pacer->max_lag_slices * pacer->slice_ns) {
+            // too far behind to catch up without a long burst, restart the schedule from now
+            pacer->resyncs++;
+            pacer->cycle_credit = 0;
+            pacer->deadline = now;
+            add_nanoseconds(&pacer->deadline, pacer->slice_ns);
+            return;
+        }
+    } else {
+        while(clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &pacer->deadline, NULL) == EINTR);
+    }
+
+    add_nanoseconds(&pacer->deadline, pacer->slice_ns);
+}
+
+void pacer_run_slice(pacer_t* pacer, i8080_t* i8080) {
+    long budget = pacer_slice_budget(pacer);
+    long executed_cycles = 0;
+    while(executed_cycles < budget) {
+        executed_cycles += decode_i8080(i8080);
+    }
+
+    pacer_end_slice(pacer, executed_cycles);
+}
+
+double pacer_effective_hz(pacer_t* pacer) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    long long elapsed_ns = difference_ns(&now, &pacer->start_time);
+    return elapsed_ns > 0 ? (double)pacer->total_cycles * NANOSECONDS_PER_SECOND / elapsed_ns : 0;
+}
+
+void pacer_print_metrics(pacer_t* pacer) {
+    printf("Clock: %.0lf Hz x %.2lf turbo, effective %.0lf Hz\n", pacer->clock_hz, pacer->turbo, pacer_effective_hz(pacer));
+    printf("Slices: %llu, overruns: %llu (max %.3lf ms, total %.3lf ms), resyncs: %llu\n",
+           (unsigned long long)pacer->slices, (unsigned long long)pacer->overruns,
+           pacer->max_overrun_ns / 1e6, pacer->total_overrun_ns / 1e6, (unsigned long long)pacer->resyncs);
+}
+
+void add_nanoseconds(struct timespec* time, long nanoseconds) {
+    time->tv_nsec += nanoseconds;
+    while(time->tv_nsec >= NANOSECONDS_PER_SECOND) {
+        time->tv_nsec -= NANOSECONDS_PER_SECOND;
+        time->tv_sec++;
+    }
+}
+
+long long difference_ns(const struct timespec* end, const struct timespec* start) {
+    return (long long)(end->tv_sec - start->tv_sec) * NANOSECONDS_PER_SECOND + (end->tv_nsec - start->tv_nsec);
+}
@@ -0,0 +1,49 @@
+#ifndef __PACER_H__
+#define __PACER_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+
+#include "i8080.h"
+
+// Paces emulation to wall-clock time. Execution is split into slices of
+// slice_ns (1 millisecond by default) worth of cycles at clock_hz * turbo, and
+// the thread sleeps until the absolute deadline of each slice with
+// clock_nanosleep, so a paced instance only uses the host cpu it needs.
+//
+// Deadlines are absolute, so sleep jitter does not accumulate and the cycles
+// executed past a slice's budget are taken off the next one. If emulation falls
+// more than max_lag_slices behind, for example after the host was suspended,
+// the schedule is reset to the current time instead of running flat out to
+// catch up.
+typedef struct pacer_t {
+    double clock_hz;
+    double turbo;
+    long slice_ns;
+    int max_lag_slices;
+
+    double cycles_per_slice;
+    double cycle_credit;
+    struct timespec start_time;
+    struct timespec deadline;
+
+    // metrics
+    uint64_t total_cycles;
+    uint64_t slices;
+    uint64_t overruns;        // slices that finished after their deadline
+    uint64_t resyncs;         // times the schedule was reset after falling too far behind
+    long max_overrun_ns;
+    long long total_overrun_ns;
+} pacer_t;
+
+pacer_t* init_pacer(double clock_hz);
+void free_pacer(pacer_t* pacer);
+void pacer_set_turbo(pacer_t* pacer, double turbo);
+long pacer_slice_budget(pacer_t* pacer);
+void pacer_end_slice(pacer_t* pacer, long executed_cycles);
+void pacer_run_slice(pacer_t* pacer, i8080_t* i8080);
+double pacer_effective_hz(pacer_t* pacer);
+void pacer_print_metrics(pacer_t* pacer);
+
+#endif // __PACER_H__
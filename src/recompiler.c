@@ -0,0 +1,707 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "i8080.h"
+
+// Ahead-of-time recompiler from a CP/M .COM image to a C translation unit.
+//
+// The image is disassembled by recursive descent from its entry point, following
+// jumps, calls and fall-through paths. Every jump or call target and every address
+// after a call, conditional branch or conditional return starts a basic block. Each
+// block becomes a label in one C function whose instructions use the same flag and
+// ALU semantics as the interpreter (i8080_instr.h). Direct jumps and calls become
+// gotos, computed targets (RET, PCHL) go through a switch on pc, and anything that
+// cannot be resolved statically returns to the runtime's interpreter (translation.h).
+//
+// Targets that are only reached through PCHL (jump tables) or computed RETs cannot
+// be found statically; they run on the interpreter unless they are given as extra
+// entry points on the command line.
+//
+// Usage: recompiler <input.COM> <output.c> [origin [entry ...]]
+
+typedef enum opcode_kind_t {
+    OPCODE_NORMAL,
+    OPCODE_STORE,  // writes memory, may overwrite translated code
+    OPCODE_JUMP,
+    OPCODE_CALL,
+    OPCODE_RET,
+    OPCODE_RST,
+    OPCODE_PCHL,
+    OPCODE_HLT
+} opcode_kind_t;
+
+typedef struct opcode_t {
+    const char* mnemonic;
+    uint8_t length;
+    opcode_kind_t kind;
+    // C statement for normal and store instructions, with 0x%02x or 0x%04x for the operand,
+    // or the branch condition for conditional jumps, calls and returns
+    const char* code;
+} opcode_t;
+
+static const opcode_t OPCODES[0x100] = {
+    [0x00] = { "NOP", 1, OPCODE_NORMAL, NULL },
+    [0x01] = { "LXI B", 3, OPCODE_NORMAL, "i8080->bc = 0x%04x;" },
+    [0x02] = { "STAX B", 1, OPCODE_STORE, "I8080_WRITE_BYTE(i8080, i8080->bc, i8080->a);" },
+    [0x03] = { "INX B", 1, OPCODE_NORMAL, "i8080->bc++;" },
+    [0x04] = { "INR B", 1, OPCODE_NORMAL, "i8080->b = i8080_instr_inr(i8080, i8080->b);" },
+    [0x05] = { "DCR B", 1, OPCODE_NORMAL, "i8080->b = i8080_instr_dcr(i8080, i8080->b);" },
+    [0x06] = { "MVI B", 2, OPCODE_NORMAL, "i8080->b = 0x%02x;" },
+    [0x07] = { "RLC", 1, OPCODE_NORMAL, "i8080_instr_rlc(i8080);" },
+    [0x08] = { "-", 1, OPCODE_NORMAL, NULL },
+    [0x09] = { "DAD B", 1, OPCODE_NORMAL, "i8080_instr_dad(i8080, i8080->bc);" },
+    [0x0a] = { "LDAX B", 1, OPCODE_NORMAL, "i8080->a = I8080_READ_BYTE(i8080, i8080->bc);" },
+    [0x0b] = { "DCX B", 1, OPCODE_NORMAL, "i8080->bc--;" },
+    [0x0c] = { "INR C", 1, OPCODE_NORMAL, "i8080->c = i8080_instr_inr(i8080, i8080->c);" },
+    [0x0d] = { "DCR C", 1, OPCODE_NORMAL, "i8080->c = i8080_instr_dcr(i8080, i8080->c);" },
+    [0x0e] = { "MVI C", 2, OPCODE_NORMAL, "i8080->c = 0x%02x;" },
+    [0x0f] = { "RRC", 1, OPCODE_NORMAL, "i8080_instr_rrc(i8080);" },
+    [0x10] = { "-", 1, OPCODE_NORMAL, NULL },
+    [0x11] = { "LXI D", 3, OPCODE_NORMAL, "i8080->de = 0x%04x;" },
+    [0x12] = { "STAX D", 1, OPCODE_STORE, "I8080_WRITE_BYTE(i8080, i8080->de, i8080->a);" },
+    [0x13] = { "INX D", 1, OPCODE_NORMAL, "i8080->de++;" },
+    [0x14] = { "INR D", 1, OPCODE_NORMAL, "i8080->d = i8080_instr_inr(i8080, i8080->d);" },
+    [0x15] = { "DCR D", 1, OPCODE_NORMAL, "i8080->d = i8080_instr_dcr(i8080, i8080->d);" },
+    [0x16] = { "MVI D", 2, OPCODE_NORMAL, "i8080->d = 0x%02x;" },
+    [0x17] = { "RAL", 1, OPCODE_NORMAL, "i8080_instr_ral(i8080);" },
+    [0x18] = { "-", 1, OPCODE_NORMAL, NULL },
+    [0x19] = { "DAD D", 1, OPCODE_NORMAL, "i8080_instr_dad(i8080, i8080->de);" },
+    [0x1a] = { "LDAX D", 1, OPCODE_NORMAL, "i8080->a = I8080_READ_BYTE(i8080, i8080->de);" },
+    [0x1b] = { "DCX D", 1, OPCODE_NORMAL, "i8080->de--;" },
+    [0x1c] = { "INR E", 1, OPCODE_NORMAL, "i8080->e = i8080_instr_inr(i8080, i8080->e);" },
+    [0x1d] = { "DCR E", 1, OPCODE_NORMAL, "i8080->e = i8080_instr_dcr(i8080, i8080->e);" },
+    [0x1e] = { "MVI E", 2, OPCODE_NORMAL, "i8080->e = 0x%02x;" },
+    [0x1f] = { "RAR", 1, OPCODE_NORMAL, "i8080_instr_rar(i8080);" },
+    [0x20] = { "-", 1, OPCODE_NORMAL, NULL },
+    [0x21] = { "LXI H", 3, OPCODE_NORMAL, "i8080->hl = 0x%04x;" },
+    [0x22] = { "SHLD", 3, OPCODE_STORE, "{ uint16_t address = 0x%04x; I8080_WRITE_BYTE(i8080, address, i8080->l); I8080_WRITE_BYTE(i8080, address + 1, i8080->h); }" },
+    [0x23] = { "INX H", 1, OPCODE_NORMAL, "i8080->hl++;" },
+    [0x24] = { "INR H", 1, OPCODE_NORMAL, "i8080->h = i8080_instr_inr(i8080, i8080->h);" },
+    [0x25] = { "DCR H", 1, OPCODE_NORMAL, "i8080->h = i8080_instr_dcr(i8080, i8080->h);" },
+    [0x26] = { "MVI H", 2, OPCODE_NORMAL, "i8080->h = 0x%02x;" },
+    [0x27] = { "DAA", 1, OPCODE_NORMAL, "i8080_instr_daa(i8080);" },
+    [0x28] = { "-", 1, OPCODE_NORMAL, NULL },
+    [0x29] = { "DAD H", 1, OPCODE_NORMAL, "i8080_instr_dad(i8080, i8080->hl);" },
+    [0x2a] = { "LHLD", 3, OPCODE_NORMAL, "{ uint16_t address = 0x%04x; i8080->l = I8080_READ_BYTE(i8080, address); i8080->h = I8080_READ_BYTE(i8080, address + 1); }" },
+    [0x2b] = { "DCX H", 1, OPCODE_NORMAL, "i8080->hl--;" },
+    [0x2c] = { "INR L", 1, OPCODE_NORMAL, "i8080->l = i8080_instr_inr(i8080, i8080->l);" },
+    [0x2d] = { "DCR L", 1, OPCODE_NORMAL, "i8080->l = i8080_instr_dcr(i8080, i8080->l);" },
+    [0x2e] = { "MVI L", 2, OPCODE_NORMAL, "i8080->l = 0x%02x;" },
+    [0x2f] = { "CMA", 1, OPCODE_NORMAL, "i8080->a ^= 0xff ;" },
+    [0x30] = { "-", 1, OPCODE_NORMAL, NULL },
+    [0x31] = { "LXI SP", 3, OPCODE_NORMAL, "i8080->sp = 0x%04x;" },
+    [0x32] = { "STA", 3, OPCODE_STORE, "I8080_WRITE_BYTE(i8080, 0x%04x, i8080->a);" },
+    [0x33] = { "INX SP", 1, OPCODE_NORMAL, "i8080->sp++;" },
+    [0x34] = { "INR M", 1, OPCODE_STORE, "I8080_WRITE_BYTE(i8080, i8080->hl, i8080_instr_inr(i8080, I8080_READ_BYTE(i8080, i8080->hl)));" },
+    [0x35] = { "DCR M", 1, OPCODE_STORE, "I8080_WRITE_BYTE(i8080, i8080->hl, i8080_instr_dcr(i8080, I8080_READ_BYTE(i8080, i8080->hl)));" },
+    [0x36] = { "MVI M", 2, OPCODE_STORE, "I8080_WRITE_BYTE(i8080, i8080->hl, 0x%02x);" },
+    [0x37] = { "STC", 1, OPCODE_NORMAL, "i8080->f |= FLAG_CY;" },
+    [0x38] = { "-", 1, OPCODE_NORMAL, NULL },
+    [0x39] = { "DAD SP", 1, OPCODE_NORMAL, "i8080_instr_dad(i8080, i8080->sp);" },
+    [0x3a] = { "LDA", 3, OPCODE_NORMAL, "i8080->a = I8080_READ_BYTE(i8080, 0x%04x);" },
+    [0x3b] = { "DCX SP", 1, OPCODE_NORMAL, "i8080->sp--;" },
+    [0x3c] = { "INR A", 1, OPCODE_NORMAL, "i8080->a = i8080_instr_inr(i8080, i8080->a);" },
+    [0x3d] = { "DCR A", 1, OPCODE_NORMAL, "i8080->a = i8080_instr_dcr(i8080, i8080->a);" },
+    [0x3e] = { "MVI A", 2, OPCODE_NORMAL, "i8080->a = 0x%02x;" },
+    [0x3f] = { "CMC", 1, OPCODE_NORMAL, "i8080->f ^= FLAG_CY;" },
+    [0x40] = { "MOV B, B", 1, OPCODE_NORMAL, "i8080->b = i8080->b;" },
+    [0x41] = { "MOV B, C", 1, OPCODE_NORMAL, "i8080->b = i8080->c;" },
+    [0x42] = { "MOV B, D", 1, OPCODE_NORMAL, "i8080->b = i8080->d;" },
+    [0x43] = { "MOV B, E", 1, OPCODE_NORMAL, "i8080->b = i8080->e;" },
+    [0x44] = { "MOV B, H", 1, OPCODE_NORMAL, "i8080->b = i8080->h;" },
+    [0x45] = { "MOV B, L", 1, OPCODE_NORMAL, "i8080->b = i8080->l;" },
+    [0x46] = { "MOV B, M", 1, OPCODE_NORMAL, "i8080->b = I8080_READ_BYTE(i8080, i8080->hl);" },
+    [0x47] = { "MOV B, A", 1, OPCODE_NORMAL, "i8080->b = i8080->a;" },
+    [0x48] = { "MOV C, B", 1, OPCODE_NORMAL, "i8080->c = i8080->b;" },
+    [0x49] = { "MOV C, C", 1, OPCODE_NORMAL, "i8080->c = i8080->c;" },
+    [0x4a] = { "MOV C, D", 1, OPCODE_NORMAL, "i8080->c = i8080->d;" },
+    [0x4b] = { "MOV C, E", 1, OPCODE_NORMAL, "i8080->c = i8080->e;" },
+    [0x4c] = { "MOV C, H", 1, OPCODE_NORMAL, "i8080->c = i8080->h;" },
+    [0x4d] = { "MOV C, L", 1, OPCODE_NORMAL, "i8080->c = i8080->l;" },
+    [0x4e] = { "MOV C, M", 1, OPCODE_NORMAL, "i8080->c = I8080_READ_BYTE(i8080, i8080->hl);" },
+    [0x4f] = { "MOV C, A", 1, OPCODE_NORMAL, "i8080->c = i8080->a;" },
+    [0x50] = { "MOV D, B", 1, OPCODE_NORMAL, "i8080->d = i8080->b;" },
+    [0x51] = { "MOV D, C", 1, OPCODE_NORMAL, "i8080->d = i8080->c;" },
+    [0x52] = { "MOV D, D", 1, OPCODE_NORMAL, "i8080->d = i8080->d;" },
+    [0x53] = { "MOV D, E", 1, OPCODE_NORMAL, "i8080->d = i8080->e;" },
+    [0x54] = { "MOV D, H", 1, OPCODE_NORMAL, "i8080->d = i8080->h;" },
+    [0x55] = { "MOV D, L", 1, OPCODE_NORMAL, "i8080->d = i8080->l;" },
+    [0x56] = { "MOV D, M", 1, OPCODE_NORMAL, "i8080->d = I8080_READ_BYTE(i8080, i8080->hl);" },
+    [0x57] = { "MOV D, A", 1, OPCODE_NORMAL, "i8080->d = i8080->a;" },
+    [0x58] = { "MOV E, B", 1, OPCODE_NORMAL, "i8080->e = i8080->b;" },
+    [0x59] = { "MOV E, C", 1, OPCODE_NORMAL, "i8080->e = i8080->c;" },
+    [0x5a] = { "MOV E, D", 1, OPCODE_NORMAL, "i8080->e = i8080->d;" },
+    [0x5b] = { "MOV E, E", 1, OPCODE_NORMAL, "i8080->e = i8080->e;" },
+    [0x5c] = { "MOV E, H", 1, OPCODE_NORMAL, "i8080->e = i8080->h;" },
+    [0x5d] = { "MOV E, L", 1, OPCODE_NORMAL, "i8080->e = i8080->l;" },
+    [0x5e] = { "MOV E, M", 1, OPCODE_NORMAL, "i8080->e = I8080_READ_BYTE(i8080, i8080->hl);" },
+    [0x5f] = { "MOV E, A", 1, OPCODE_NORMAL, "i8080->e = i8080->a;" },
+    [0x60] = { "MOV H, B", 1, OPCODE_NORMAL, "i8080->h = i8080->b;" },
+    [0x61] = { "MOV H, C", 1, OPCODE_NORMAL, "i8080->h = i8080->c;" },
+    [0x62] = { "MOV H, D", 1, OPCODE_NORMAL, "i8080->h = i8080->d;" },
+    [0x63] = { "MOV H, E", 1, OPCODE_NORMAL, "i8080->h = i8080->e;" },
+    [0x64] = { "MOV H, H", 1, OPCODE_NORMAL, "i8080->h = i8080->h;" },
+    [0x65] = { "MOV H, L", 1, OPCODE_NORMAL, "i8080->h = i8080->l;" },
+    [0x66] = { "MOV H, M", 1, OPCODE_NORMAL, "i8080->h = I8080_READ_BYTE(i8080, i8080->hl);" },
+    [0x67] = { "MOV H, A", 1, OPCODE_NORMAL, "i8080->h = i8080->a;" },
+    [0x68] = { "MOV L, B", 1, OPCODE_NORMAL, "i8080->l = i8080->b;" },
+    [0x69] = { "MOV L, C", 1, OPCODE_NORMAL, "i8080->l = i8080->c;" },
+    [0x6a] = { "MOV L, D", 1, OPCODE_NORMAL, "i8080->l = i8080->d;" },
+    [0x6b] = { "MOV L, E", 1, OPCODE_NORMAL, "i8080->l = i8080->e;" },
+    [0x6c] = { "MOV L, H", 1, OPCODE_NORMAL, "i8080->l = i8080->h;" },
+    [0x6d] = { "MOV L, L", 1, OPCODE_NORMAL, "i8080->l = i8080->l;" },
+    [0x6e] = { "MOV L, M", 1, OPCODE_NORMAL, "i8080->l = I8080_READ_BYTE(i8080, i8080->hl);" },
+    [0x6f] = { "MOV L, A", 1, OPCODE_NORMAL, "i8080->l = i8080->a;" },
+    [0x70] = { "MOV M, B", 1, OPCODE_STORE, "I8080_WRITE_BYTE(i8080, i8080->hl, i8080->b);" },
+    [0x71] = { "MOV M, C", 1, OPCODE_STORE, "I8080_WRITE_BYTE(i8080, i8080->hl, i8080->c);" },
+    [0x72] = { "MOV M, D", 1, OPCODE_STORE, "I8080_WRITE_BYTE(i8080, i8080->hl, i8080->d);" },
+    [0x73] = { "MOV M, E", 1, OPCODE_STORE, "I8080_WRITE_BYTE(i8080, i8080->hl, i8080->e);" },
+    [0x74] = { "MOV M, H", 1, OPCODE_STORE, "I8080_WRITE_BYTE(i8080, i8080->hl, i8080->h);" },
+    [0x75] = { "MOV M, L", 1, OPCODE_STORE, "I8080_WRITE_BYTE(i8080, i8080->hl, i8080->l);" },
+    [0x76] = { "HLT", 1, OPCODE_HLT, NULL },
+    [0x77] = { "MOV M, A", 1, OPCODE_STORE, "I8080_WRITE_BYTE(i8080, i8080->hl, i8080->a);" },
+    [0x78] = { "MOV A, B", 1, OPCODE_NORMAL, "i8080->a = i8080->b;" },
+    [0x79] = { "MOV A, C", 1, OPCODE_NORMAL, "i8080->a = i8080->c;" },
+    [0x7a] = { "MOV A, D", 1, OPCODE_NORMAL, "i8080->a = i8080->d;" },
+    [0x7b] = { "MOV A, E", 1, OPCODE_NORMAL, "i8080->a = i8080->e;" },
+    [0x7c] = { "MOV A, H", 1, OPCODE_NORMAL, "i8080->a = i8080->h;" },
+    [0x7d] = { "MOV A, L", 1, OPCODE_NORMAL, "i8080->a = i8080->l;" },
+    [0x7e] = { "MOV A, M", 1, OPCODE_NORMAL, "i8080->a = I8080_READ_BYTE(i8080, i8080->hl);" },
+    [0x7f] = { "MOV A, A", 1, OPCODE_NORMAL, "i8080->a = i8080->a;" },
+    [0x80] = { "ADD B", 1, OPCODE_NORMAL, "i8080->a = i8080_instr_add(i8080, i8080->b, false);" },
+    [0x81] = { "ADD C", 1, OPCODE_NORMAL, "i8080->a = i8080_instr_add(i8080, i8080->c, false);" },
+    [0x82] = { "ADD D", 1, OPCODE_NORMAL, "i8080->a = i8080_instr_add(i8080, i8080->d, false);" },
+    [0x83] = { "ADD E", 1, OPCODE_NORMAL, "i8080->a = i8080_instr_add(i8080, i8080->e, false);" },
+    [0x84] = { "ADD H", 1, OPCODE_NORMAL, "i8080->a = i8080_instr_add(i8080, i8080->h, false);" },
+    [0x85] = { "ADD L", 1, OPCODE_NORMAL, "i8080->a = i8080_instr_add(i8080, i8080->l, false);" },
+    [0x86] = { "ADD M", 1, OPCODE_NORMAL, "i8080->a = i8080_instr_add(i8080, I8080_READ_BYTE(i8080, i8080->hl), false);" },
+    [0x87] = { "ADD A", 1, OPCODE_NORMAL, "i8080->a = i8080_instr_add(i8080, i8080->a, false);" },
+    [0x88] = { "ADC B", 1, OPCODE_NORMAL, "i8080->a = i8080_instr_add(i8080, i8080->b, (i8080->f & FLAG_CY));" },
+    [0x89] = { "ADC C", 1, OPCODE_NORMAL, "i8080->a = i8080_instr_add(i8080, i8080->c, (i8080->f & FLAG_CY));" },
+    [0x8a] = { "ADC D", 1, OPCODE_NORMAL, "i8080->a = i8080_instr_add(i8080, i8080->d, (i8080->f & FLAG_CY));" },
+    [0x8b] = { "ADC E", 1, OPCODE_NORMAL, "i8080->a = i8080_instr_add(i8080, i8080->e, (i8080->f & FLAG_CY));" },
+    [0x8c] = { "ADC H", 1, OPCODE_NORMAL, "i8080->a = i8080_instr_add(i8080, i8080->h, (i8080->f & FLAG_CY));" },
+    [0x8d] = { "ADC L", 1, OPCODE_NORMAL, "i8080->a = i8080_instr_add(i8080, i8080->l, (i8080->f & FLAG_CY));" },
+    [0x8e] = { "ADC M", 1, OPCODE_NORMAL, "i8080->a = i8080_instr_add(i8080, I8080_READ_BYTE(i8080, i8080->hl), (i8080->f & FLAG_CY));" },
+    [0x8f] = { "ADC A", 1, OPCODE_NORMAL, "i8080->a = i8080_instr_add(i8080, i8080->a, (i8080->f & FLAG_CY));" },
+    [0x90] = { "SUB B", 1, OPCODE_NORMAL, "i8080->a = i8080_instr_sub(i8080, i8080->b, false);" },
+    [0x91] = { "SUB C", 1, OPCODE_NORMAL, "i8080->a = i8080_instr_sub(i8080, i8080->c, false);" },
+    [0x92] = { "SUB D", 1, OPCODE_NORMAL, "i8080->a = i8080_instr_sub(i8080, i8080->d, false);" },
+    [0x93] = { "SUB E", 1, OPCODE_NORMAL, "i8080->a = i8080_instr_sub(i8080, i8080->e, false);" },
+    [0x94] = { "SUB H", 1, OPCODE_NORMAL, "i8080->a = i8080_instr_sub(i8080, i8080->h, false);" },
+    [0x95] = { "SUB L", 1, OPCODE_NORMAL, "i8080->a = i8080_instr_sub(i8080, i8080->l, false);" },
+    [0x96] = { "SUB M", 1, OPCODE_NORMAL, "i8080->a = i8080_instr_sub(i8080, I8080_READ_BYTE(i8080, i8080->hl), false);" },
+    [0x97] = { "SUB A", 1, OPCODE_NORMAL, "i8080->a = i8080_instr_sub(i8080, i8080->a, false);" },
+    [0x98] = { "SBB B", 1, OPCODE_NORMAL, "i8080->a = i8080_instr_sub(i8080, i8080->b, (i8080->f & FLAG_CY));" },
+    [0x99] = { "SBB C", 1, OPCODE_NORMAL, "i8080->a = i8080_instr_sub(i8080, i8080->c, (i8080->f & FLAG_CY));" },
+    [0x9a] = { "SBB D", 1, OPCODE_NORMAL, "i8080->a = i8080_instr_sub(i8080, i8080->d, (i8080->f & FLAG_CY));" },
+    [0x9b] = { "SBB E", 1, OPCODE_NORMAL, "i8080->a = i8080_instr_sub(i8080, i8080->e, (i8080->f & FLAG_CY));" },
+    [0x9c] = { "SBB H", 1, OPCODE_NORMAL, "i8080->a = i8080_instr_sub(i8080, i8080->h, (i8080->f & FLAG_CY));" },
+    [0x9d] = { "SBB L", 1, OPCODE_NORMAL, "i8080->a = i8080_instr_sub(i8080, i8080->l, (i8080->f & FLAG_CY));" },
+    [0x9e] = { "SBB M", 1, OPCODE_NORMAL, "i8080->a = i8080_instr_sub(i8080, I8080_READ_BYTE(i8080, i8080->hl), (i8080->f & FLAG_CY));" },
+    [0x9f] = { "SBB A", 1, OPCODE_NORMAL, "i8080->a = i8080_instr_sub(i8080, i8080->a, (i8080->f & FLAG_CY));" },
+    [0xa0] = { "ANA B", 1, OPCODE_NORMAL, "i8080->a = i8080_instr_ana(i8080, i8080->b);" },
+    [0xa1] = { "ANA C", 1, OPCODE_NORMAL, "i8080->a = i8080_instr_ana(i8080, i8080->c);" },
+    [0xa2] = { "ANA D", 1, OPCODE_NORMAL, "i8080->a = i8080_instr_ana(i8080, i8080->d);" },
+    [0xa3] = { "ANA E", 1, OPCODE_NORMAL, "i8080->a = i8080_instr_ana(i8080, i8080->e);" },
+    [0xa4] = { "ANA H", 1, OPCODE_NORMAL, "i8080->a = i8080_instr_ana(i8080, i8080->h);" },
+    [0xa5] = { "ANA L", 1, OPCODE_NORMAL, "i8080->a = i8080_instr_ana(i8080, i8080->l);" },
+    [0xa6] = { "ANA M", 1, OPCODE_NORMAL, "i8080->a = i8080_instr_ana(i8080, I8080_READ_BYTE(i8080, i8080->hl));" },
+    [0xa7] = { "ANA A", 1, OPCODE_NORMAL, "i8080->a = i8080_instr_ana(i8080, i8080->a);" },
+    [0xa8] = { "XRA B", 1, OPCODE_NORMAL, "i8080->a = i8080_instr_xra(i8080, i8080->b);" },
+    [0xa9] = { "XRA C", 1, OPCODE_NORMAL, "i8080->a = i8080_instr_xra(i8080, i8080->c);" },
+    [0xaa] = { "XRA D", 1, OPCODE_NORMAL, "i8080->a = i8080_instr_xra(i8080, i8080->d);" },
+    [0xab] = { "XRA E", 1, OPCODE_NORMAL, "i8080->a = i8080_instr_xra(i8080, i8080->e);" },
+    [0xac] = { "XRA H", 1, OPCODE_NORMAL, "i8080->a = i8080_instr_xra(i8080, i8080->h);" },
+    [0xad] = { "XRA L", 1, OPCODE_NORMAL, "i8080->a = i8080_instr_xra(i8080, i8080->l);" },
+    [0xae] = { "XRA M", 1, OPCODE_NORMAL, "i8080->a = i8080_instr_xra(i8080, I8080_READ_BYTE(i8080, i8080->hl));" },
+    [0xaf] = { "XRA A", 1, OPCODE_NORMAL, "i8080->a = i8080_instr_xra(i8080, i8080->a);" },
+    [0xb0] = { "ORA B", 1, OPCODE_NORMAL, "i8080->a = i8080_instr_ora(i8080, i8080->b);" },
+    [0xb1] = { "ORA C", 1, OPCODE_NORMAL, "i8080->a = i8080_instr_ora(i8080, i8080->c);" },
+    [0xb2] = { "ORA D", 1, OPCODE_NORMAL, "i8080->a = i8080_instr_ora(i8080, i8080->d);" },
+    [0xb3] = { "ORA E", 1, OPCODE_NORMAL, "i8080->a = i8080_instr_ora(i8080, i8080->e);" },
+    [0xb4] = { "ORA H", 1, OPCODE_NORMAL, "i8080->a = i8080_instr_ora(i8080, i8080->h);" },
+    [0xb5] = { "ORA L", 1, OPCODE_NORMAL, "i8080->a = i8080_instr_ora(i8080, i8080->l);" },
+    [0xb6] = { "ORA M", 1, OPCODE_NORMAL, "i8080->a = i8080_instr_ora(i8080, I8080_READ_BYTE(i8080, i8080->hl));" },
+    [0xb7] = { "ORA A", 1, OPCODE_NORMAL, "i8080->a = i8080_instr_ora(i8080, i8080->a);" },
+    [0xb8] = { "CMP B", 1, OPCODE_NORMAL, "i8080_instr_sub(i8080, i8080->b, false);" },
+    [0xb9] = { "CMP C", 1, OPCODE_NORMAL, "i8080_instr_sub(i8080, i8080->c, false);" },
+    [0xba] = { "CMP D", 1, OPCODE_NORMAL, "i8080_instr_sub(i8080, i8080->d, false);" },
+    [0xbb] = { "CMP E", 1, OPCODE_NORMAL, "i8080_instr_sub(i8080, i8080->e, false);" },
+    [0xbc] = { "CMP H", 1, OPCODE_NORMAL, "i8080_instr_sub(i8080, i8080->h, false);" },
+    [0xbd] = { "CMP L", 1, OPCODE_NORMAL, "i8080_instr_sub(i8080, i8080->l, false);" },
+    [0xbe] = { "CMP M", 1, OPCODE_NORMAL, "i8080_instr_sub(i8080, I8080_READ_BYTE(i8080, i8080->hl), false);" },
+    [0xbf] = { "CMP A", 1, OPCODE_NORMAL, "i8080_instr_sub(i8080, i8080->a, false);" },
+    [0xc0] = { "RNZ", 1, OPCODE_RET, "!(i8080->f & FLAG_Z)" },
+    [0xc1] = { "POP B", 1, OPCODE_NORMAL, "i8080->bc = i8080_instr_pop(i8080);" },
+    [0xc2] = { "JNZ", 3, OPCODE_JUMP, "!(i8080->f & FLAG_Z)" },
+    [0xc3] = { "JMP", 3, OPCODE_JUMP, "true" },
+    [0xc4] = { "CNZ", 3, OPCODE_CALL, "!(i8080->f & FLAG_Z)" },
+    [0xc5] = { "PUSH B", 1, OPCODE_STORE, "i8080_instr_push(i8080, i8080->bc);" },
+    [0xc6] = { "ADI", 2, OPCODE_NORMAL, "i8080->a = i8080_instr_add(i8080, 0x%02x, false);" },
+    [0xc7] = { "RST 0", 1, OPCODE_RST, NULL },
+    [0xc8] = { "RZ", 1, OPCODE_RET, "(i8080->f & FLAG_Z)" },
+    [0xc9] = { "RET", 1, OPCODE_RET, "true" },
+    [0xca] = { "JZ", 3, OPCODE_JUMP, "(i8080->f & FLAG_Z)" },
+    [0xcb] = { "-", 3, OPCODE_JUMP, "true" },
+    [0xcc] = { "CZ", 3, OPCODE_CALL, "(i8080->f & FLAG_Z)" },
+    [0xcd] = { "CALL", 3, OPCODE_CALL, "true" },
+    [0xce] = { "ACI", 2, OPCODE_NORMAL, "i8080->a = i8080_instr_add(i8080, 0x%02x, (i8080->f & FLAG_CY));" },
+    [0xcf] = { "RST 1", 1, OPCODE_RST, NULL },
+    [0xd0] = { "RNC", 1, OPCODE_RET, "!(i8080->f & FLAG_CY)" },
+    [0xd1] = { "POP D", 1, OPCODE_NORMAL, "i8080->de = i8080_instr_pop(i8080);" },
+    [0xd2] = { "JNC", 3, OPCODE_JUMP, "!(i8080->f & FLAG_CY)" },
+    [0xd3] = { "OUT", 2, OPCODE_NORMAL, "i8080_instr_out(i8080, 0x%02x);" },
+    [0xd4] = { "CNC", 3, OPCODE_CALL, "!(i8080->f & FLAG_CY)" },
+    [0xd5] = { "PUSH D", 1, OPCODE_STORE, "i8080_instr_push(i8080, i8080->de);" },
+    [0xd6] = { "SUI", 2, OPCODE_NORMAL, "i8080->a = i8080_instr_sub(i8080, 0x%02x, false);" },
+    [0xd7] = { "RST 2", 1, OPCODE_RST, NULL },
+    [0xd8] = { "RC", 1, OPCODE_RET, "(i8080->f & FLAG_CY)" },
+    [0xd9] = { "-", 1, OPCODE_RET, "true" },
+    [0xda] = { "JC", 3, OPCODE_JUMP, "(i8080->f & FLAG_CY)" },
+    [0xdb] = { "IN", 2, OPCODE_NORMAL, "i8080_instr_in(i8080, 0x%02x);" },
+    [0xdc] = { "CC", 3, OPCODE_CALL, "(i8080->f & FLAG_CY)" },
+    [0xdd] = { "-", 3, OPCODE_CALL, "true" },
+    [0xde] = { "SBI", 2, OPCODE_NORMAL, "i8080->a = i8080_instr_sub(i8080, 0x%02x, (i8080->f & FLAG_CY));" },
+    [0xdf] = { "RST 3", 1, OPCODE_RST, NULL },
+    [0xe0] = { "RPO", 1, OPCODE_RET, "!(i8080->f & FLAG_P)" },
+    [0xe1] = { "POP H", 1, OPCODE_NORMAL, "i8080->hl = i8080_instr_pop(i8080);" },
+    [0xe2] = { "JPO", 3, OPCODE_JUMP, "!(i8080->f & FLAG_P)" },
+    [0xe3] = { "XTHL", 1, OPCODE_STORE, "i8080_instr_xthl(i8080);" },
+    [0xe4] = { "CPO", 3, OPCODE_CALL, "!(i8080->f & FLAG_P)" },
+    [0xe5] = { "PUSH H", 1, OPCODE_STORE, "i8080_instr_push(i8080, i8080->hl);" },
+    [0xe6] = { "ANI", 2, OPCODE_NORMAL, "i8080->a = i8080_instr_ana(i8080, 0x%02x);" },
+    [0xe7] = { "RST 4", 1, OPCODE_RST, NULL },
+    [0xe8] = { "RPE", 1, OPCODE_RET, "(i8080->f & FLAG_P)" },
+    [0xe9] = { "PCHL", 1, OPCODE_PCHL, NULL },
+    [0xea] = { "JPE", 3, OPCODE_JUMP, "(i8080->f & FLAG_P)" },
+    [0xeb] = { "XCHG", 1, OPCODE_NORMAL, "i8080_instr_xchg(i8080);" },
+    [0xec] = { "CPE", 3, OPCODE_CALL, "(i8080->f & FLAG_P)" },
+    [0xed] = { "-", 3, OPCODE_CALL, "true" },
+    [0xee] = { "XRI", 2, OPCODE_NORMAL, "i8080->a = i8080_instr_xra(i8080, 0x%02x);" },
+    [0xef] = { "RST 5", 1, OPCODE_RST, NULL },
+    [0xf0] = { "RP", 1, OPCODE_RET, "!(i8080->f & FLAG_S)" },
+    [0xf1] = { "POP PSW", 1, OPCODE_NORMAL, "i8080_instr_pop_psw(i8080);" },
+    [0xf2] = { "JP", 3, OPCODE_JUMP, "!(i8080->f & FLAG_S)" },
+    [0xf3] = { "DI", 1, OPCODE_NORMAL, "i8080->interrupt_enabled = false; i8080->interrupt_pending = false;" },
+    [0xf4] = { "CP", 3, OPCODE_CALL, "!(i8080->f & FLAG_S)" },
+    [0xf5] = { "PUSH PSW", 1, OPCODE_STORE, "i8080_instr_push(i8080, i8080->af);" },
+    [0xf6] = { "ORI", 2, OPCODE_NORMAL, "i8080->a = i8080_instr_ora(i8080, 0x%02x);" },
+    [0xf7] = { "RST 6", 1, OPCODE_RST, NULL },
+    [0xf8] = { "RM", 1, OPCODE_RET, "(i8080->f & FLAG_S)" },
+    [0xf9] = { "SPHL", 1, OPCODE_NORMAL, "i8080->sp = i8080->hl;" },
+    [0xfa] = { "JM", 3, OPCODE_JUMP, "(i8080->f & FLAG_S)" },
+    [0xfb] = { "EI", 1, OPCODE_NORMAL, "i8080->interrupt_pending = true;" },
+    [0xfc] = { "CM", 3, OPCODE_CALL, "(i8080->f & FLAG_S)" },
+    [0xfd] = { "-", 3, OPCODE_CALL, "true" },
+    [0xfe] = { "CPI", 2, OPCODE_NORMAL, "i8080_instr_sub(i8080, 0x%02x, false);" },
+    [0xff] = { "RST 7", 1, OPCODE_RST, NULL },
+};
+
+static const int MEMORY_SIZE = 0x10000;
+static const int MAX_BLOCK_INSTRUCTIONS = 0x10000;
+
+static uint8_t* memory;
+static uint16_t origin;
+static uint32_t image_size;
+static bool* instruction_start;
+static bool* block_start;
+static uint8_t* code_map;
+static int* block_number;
+static uint16_t* block_ends;
+
+static bool load_image(const char* rom_filename);
+static bool in_image(uint32_t address);
+static uint16_t operand(uint16_t address);
+static uint16_t branch_target(uint16_t address);
+static bool analyze(int entry_count, char* entries[]);
+static void add_block(uint16_t address, uint16_t* worklist, int* worklist_count);
+static bool emit_translation(const char* c_filename);
+static void emit_block(FILE* fp, uint16_t leader, uint16_t* instructions);
+static void emit_condition(FILE* fp, const opcode_t* opcode);
+static void emit_end_condition(FILE* fp, const opcode_t* opcode);
+static bool is_conditional(const opcode_t* opcode);
+static void emit_exit(FILE* fp, const char* indent, uint16_t pc);
+static void emit_branch(FILE* fp, const char* indent, uint16_t target);
+
+int main(int argc, char* argv[]) {
+    if(argc < 3) {
+        printf("Usage: %s <input.COM> <output.c> [origin [entry ...]]\n", argv[0]);
+        return 1;
+    }
+
+    origin = argc > 3 ? strtol(argv[3], NULL, 0) : 0x0100;
+    memory = calloc(MEMORY_SIZE, sizeof(uint8_t));
+    instruction_start = calloc(MEMORY_SIZE, sizeof(bool));
+    block_start = calloc(MEMORY_SIZE, sizeof(bool));
+    code_map = calloc(MEMORY_SIZE / 8, sizeof(uint8_t));
+    block_number = calloc(MEMORY_SIZE, sizeof(int));
+    block_ends = calloc(MEMORY_SIZE, sizeof(uint16_t));
+
+    if(memory == NULL || instruction_start == NULL || block_start == NULL || code_map == NULL ||
+       block_number == NULL || block_ends == NULL) {
+        printf("Error could not allocate memory\n");
+        return 1;
+    }
+
+    if(!load_image(argv[1])) {
+        return 1;
+    }
+
+    if(!analyze(argc > 4 ? argc - 4 : 0, argv + 4) || !emit_translation(argv[2])) {
+        return 1;
+    }
+
+    free(memory);
+    free(instruction_start);
+    free(block_start);
+    free(code_map);
+    free(block_number);
+    free(block_ends);
+    return 0;
+}
+
+bool load_image(const char* rom_filename) {
+    FILE* fp = fopen(rom_filename, "rb");
+    if(fp == NULL) {
+        printf("Error could not open the file '%s' for reading.\n", rom_filename);
+        return false;
+    }
+
+    image_size = fread(memory + origin, 1, MEMORY_SIZE - origin, fp);
+    fclose(fp);
+
+    if(image_size == 0) {
+        printf("Error the file '%s' is empty.\n", rom_filename);
+        return false;
+    }
+
+    return true;
+}
+
+bool in_image(uint32_t address) {
+    return address >= origin && address < origin + image_size;
+}
+
+uint16_t operand(uint16_t address) {
+    if(OPCODES[memory[address]].length == 2) {
+        return memory[(uint16_t)(address + 1)];
+    }
+    return memory[(uint16_t)(address + 1)] | (memory[(uint16_t)(address + 2)] << 8);
+}
+
+uint16_t branch_target(uint16_t address) {
+    // the RST instructions call 0x0000, 0x0008, ... 0x0038, encoded in bits 3 to 5
+    uint8_t opcode = memory[address];
+    return OPCODES[opcode].kind == OPCODE_RST ? (opcode & 0x38) : operand(address);
+}
+
+bool analyze(int entry_count, char* entries[]) {
+    uint16_t* worklist = malloc(MEMORY_SIZE * sizeof(uint16_t));
+    if(worklist == NULL) {
+        printf("Error could not allocate memory\n");
+        return false;
+    }
+
+    int worklist_count = 0;
+    add_block(origin, worklist, &worklist_count);
+    for(int i = 0; i < entry_count; ++i) {
+        add_block(strtol(entries[i], NULL, 0), worklist, &worklist_count);
+    }
+
+    while(worklist_count > 0) {
+        uint32_t address = worklist[--worklist_count];
+
+        while(in_image(address)) {
+            if(instruction_start[address]) {
+                // joined code that was already decoded, the join point starts a block
+                block_start[address] = true;
+                break;
+            }
+
+            const opcode_t* opcode = &OPCODES[memory[address]];
+            if(!in_image(address + opcode->length - 1)) {
+                break;
+            }
+
+            instruction_start[address] = true;
+            for(int i = 0; i < opcode->length; ++i) {
+                code_map[(address + i) >> 3] |= 1 << ((address + i) & 7);
+            }
+
+            uint32_t next = address + opcode->length;
+            bool conditional = is_conditional(opcode);
+
+            if(opcode->kind == OPCODE_JUMP || opcode->kind == OPCODE_CALL || opcode->kind == OPCODE_RST) {
+                add_block(branch_target(address), worklist, &worklist_count);
+            }
+
+            if(opcode->kind == OPCODE_PCHL || opcode->kind == OPCODE_HLT ||
+               ((opcode->kind == OPCODE_JUMP || opcode->kind == OPCODE_RET) && !conditional)) {
+                break;
+            }
+
+            // code after a call or a conditional branch is reached from elsewhere too
+            if(opcode->kind != OPCODE_NORMAL && opcode->kind != OPCODE_STORE && in_image(next)) {
+                block_start[next] = true;
+            }
+
+            address = next;
+        }
+    }
+
+    free(worklist);
+    return true;
+}
+
+void add_block(uint16_t address, uint16_t* worklist, int* worklist_count) {
+    if(!in_image(address) || block_start[address]) {
+        return;
+    }
+
+    block_start[address] = true;
+    worklist[(*worklist_count)++] = address;
+}
+
+bool emit_translation(const char* c_filename) {
+    uint16_t* instructions = malloc(MAX_BLOCK_INSTRUCTIONS * sizeof(uint16_t));
+    if(instructions == NULL) {
+        printf("Error could not allocate memory\n");
+        return false;
+    }
+
+    FILE* fp = fopen(c_filename, "w");
+    if(fp == NULL) {
+        printf("Error could not open the file '%s' for writing.\n", c_filename);
+        free(instructions);
+        return false;
+    }
+
+    int block_count = 0, instruction_count = 0;
+    bool uses_dispatch = false; // only RET and PCHL jump back to the dispatch switch
+    for(uint32_t address = 0; address < (uint32_t)MEMORY_SIZE; ++address) {
+        // a block start whose code runs off the image is not translated and left to the interpreter
+        if(block_start[address] && !instruction_start[address]) {
+            block_start[address] = false;
+        }
+        if(block_start[address]) {
+            block_number[address] = block_count++;
+        }
+        instruction_count += instruction_start[address];
+        if(instruction_start[address]) {
+            opcode_kind_t kind = OPCODES[memory[address]].kind;
+            uses_dispatch |= kind == OPCODE_RET || kind == OPCODE_PCHL;
+        }
+    }
+
+    fprintf(fp, "// Generated by the i8080 recompiler, do not edit.\n");
+    fprintf(fp, "// %d instructions in %d blocks, origin 0x%04x, %u bytes.\n\n", instruction_count, block_count, origin, image_size);
+    fprintf(fp, "#include \"i8080_instr.h\"\n#include \"translation.h\"\n\n");
+
+    fprintf(fp, "static const uint8_t IMAGE[%u] = {", image_size);
+    for(uint32_t i = 0; i < image_size; ++i) {
+        fprintf(fp, "%s0x%02x,", i % 16 == 0 ? "\n    " : " ", memory[origin + i]);
+    }
+    fprintf(fp, "\n};\n\n");
+
+    fprintf(fp, "static const uint8_t CODE_MAP[0x%x] = {", MEMORY_SIZE / 8);
+    for(int i = 0; i < MEMORY_SIZE / 8; ++i) {
+        fprintf(fp, "%s0x%02x,", i % 16 == 0 ? "\n    " : " ", code_map[i]);
+    }
+    fprintf(fp, "\n};\n\n");
+
+    fprintf(fp, "static void run(i8080_t* i8080, translation_state_t* state) {\n");
+    fprintf(fp, "    state->exit_requested = false;\n\n");
+    if(uses_dispatch) {
+        fprintf(fp, "dispatch:\n");
+    }
+    fprintf(fp, "    switch(i8080->pc) {\n");
+    for(uint32_t address = 0; address < (uint32_t)MEMORY_SIZE; ++address) {
+        if(block_start[address]) {
+            fprintf(fp, "        case 0x%04x: goto block_%04x;\n", address, address);
+        }
+    }
+    fprintf(fp, "        default: return;\n");
+    fprintf(fp, "    }\n");
+
+    for(uint32_t address = 0; address < (uint32_t)MEMORY_SIZE; ++address) {
+        if(block_start[address]) {
+            emit_block(fp, address, instructions);
+        }
+    }
+    free(instructions);
+
+    fprintf(fp, "}\n\n");
+
+    fprintf(fp, "static const uint16_t BLOCK_STARTS[%d] = {", block_count > 0 ? block_count : 1);
+    for(uint32_t address = 0, i = 0; address < (uint32_t)MEMORY_SIZE; ++address) {
+        if(block_start[address]) {
+            fprintf(fp, "%s0x%04x,", i++ % 8 == 0 ? "\n    " : " ", address);
+        }
+    }
+    fprintf(fp, "\n};\n\n");
+
+    fprintf(fp, "static const uint16_t BLOCK_ENDS[%d] = {", block_count > 0 ? block_count : 1);
+    for(uint32_t address = 0, i = 0; address < (uint32_t)MEMORY_SIZE; ++address) {
+        if(block_start[address]) {
+            fprintf(fp, "%s0x%04x,", i++ % 8 == 0 ? "\n    " : " ", block_ends[address]);
+        }
+    }
+    fprintf(fp, "\n};\n\n");
+
+    fprintf(fp, "const translation_t translation = {\n");
+    fprintf(fp, "    .origin = 0x%04x,\n", origin);
+    fprintf(fp, "    .image_size = %u,\n", image_size);
+    fprintf(fp, "    .image = IMAGE,\n");
+    fprintf(fp, "    .code_map = CODE_MAP,\n");
+    fprintf(fp, "    .block_count = %d,\n", block_count);
+    fprintf(fp, "    .block_starts = BLOCK_STARTS,\n");
+    fprintf(fp, "    .block_ends = BLOCK_ENDS,\n");
+    fprintf(fp, "    .instruction_count = %d,\n", instruction_count);
+    fprintf(fp, "    .run = run\n");
+    fprintf(fp, "};\n");
+
+    bool success = ferror(fp) == 0;
+    fclose(fp);
+
+    if(!success) {
+        printf("Error could not write the translation to '%s'.\n", c_filename);
+        return false;
+    }
+
+    printf("Translated %d instructions in %d blocks into '%s'\n", instruction_count, block_count, c_filename);
+    return true;
+}
+
+void emit_block(FILE* fp, uint16_t leader, uint16_t* instructions) {
+    // collect the instructions up to the next block or the end of the straight line code
+    int count = 0;
+    uint32_t address = leader;
+    uint32_t next = leader;
+    bool falls_through = true;
+
+    while(falls_through && in_image(address) && instruction_start[address] && (count == 0 || !block_start[address]) && count < MAX_BLOCK_INSTRUCTIONS) {
+        const opcode_t* opcode = &OPCODES[memory[address]];
+        bool conditional = is_conditional(opcode);
+
+        instructions[count++] = address;
+        next = address + opcode->length;
+        falls_through = !(opcode->kind == OPCODE_PCHL || opcode->kind == OPCODE_HLT ||
+                          ((opcode->kind == OPCODE_JUMP || opcode->kind == OPCODE_RET) && !conditional));
+        address = next;
+    }
+
+    block_ends[leader] = instructions[count - 1] + OPCODES[memory[instructions[count - 1]]].length - 1;
+    fprintf(fp, "\nblock_%04x:\n", leader);
+    fprintf(fp, "    if(state->dirty_blocks[%d]) {\n", block_number[leader]);
+    emit_exit(fp, "        ", leader);
+    fprintf(fp, "    }\n");
+
+    for(int i = 0; i < count; ++i) {
+        uint16_t pc = instructions[i];
+        const opcode_t* opcode = &OPCODES[memory[pc]];
+        uint16_t next_pc = pc + opcode->length;
+
+        fprintf(fp, "    // 0x%04x: %s", pc, opcode->mnemonic);
+        if(opcode->length == 2) {
+            fprintf(fp, " #0x%02x", operand(pc));
+        } else if(opcode->length == 3) {
+            fprintf(fp, " 0x%04x", operand(pc));
+        }
+        fprintf(fp, "\n");
+
+        switch(opcode->kind) {
+            case OPCODE_NORMAL:
+            case OPCODE_STORE:
+                if(opcode->code != NULL) {
+                    fprintf(fp, "    ");
+                    fprintf(fp, opcode->code, operand(pc));
+                    fprintf(fp, "\n");
+                }
+                if(opcode->kind == OPCODE_STORE) {
+                    fprintf(fp, "    if(state->exit_requested) {\n");
+                    emit_exit(fp, "        ", next_pc);
+                    fprintf(fp, "    }\n");
+                }
+                break;
+
+            case OPCODE_JUMP:
+                emit_condition(fp, opcode);
+                emit_branch(fp, is_conditional(opcode) ? "        " : "    ", branch_target(pc));
+                emit_end_condition(fp, opcode);
+                break;
+
+            case OPCODE_CALL:
+            case OPCODE_RST: {
+                const char* indent = is_conditional(opcode) ? "        " : "    ";
+                emit_condition(fp, opcode);
+                fprintf(fp, "%si8080_instr_push(i8080, 0x%04x);\n", indent, next_pc);
+                fprintf(fp, "%sif(state->exit_requested) {\n", indent);
+                fprintf(fp, "%s    i8080->pc = 0x%04x;\n", indent, branch_target(pc));
+                fprintf(fp, "%s    return;\n", indent);
+                fprintf(fp, "%s}\n", indent);
+                emit_branch(fp, indent, branch_target(pc));
+                emit_end_condition(fp, opcode);
+                break;
+            }
+
+            case OPCODE_RET: {
+                const char* indent = is_conditional(opcode) ? "        " : "    ";
+                emit_condition(fp, opcode);
+                fprintf(fp, "%si8080->pc = i8080_instr_pop(i8080);\n", indent);
+                fprintf(fp, "%sgoto dispatch;\n", indent);
+                emit_end_condition(fp, opcode);
+                break;
+            }
+
+            case OPCODE_PCHL:
+                fprintf(fp, "    i8080->pc = i8080->hl;\n");
+                fprintf(fp, "    goto dispatch;\n");
+                break;
+
+            case OPCODE_HLT:
+                // halting is left to the interpreter
+                emit_exit(fp, "    ", pc);
+                break;
+        }
+    }
+
+    // fall through into the next block, or back to the interpreter at the end of the translated code
+    const opcode_t* opcode = &OPCODES[memory[instructions[count - 1]]];
+    if(!(opcode->kind == OPCODE_PCHL || opcode->kind == OPCODE_HLT || opcode->kind == OPCODE_RST ||
+         ((opcode->kind == OPCODE_JUMP || opcode->kind == OPCODE_CALL || opcode->kind == OPCODE_RET) && !is_conditional(opcode)))) {
+        emit_branch(fp, "    ", next);
+    }
+}
+
+void emit_condition(FILE* fp, const opcode_t* opcode) {
+    if(is_conditional(opcode)) {
+        fprintf(fp, "    if(%s) {\n", opcode->code);
+    }
+}
+
+void emit_end_condition(FILE* fp, const opcode_t* opcode) {
+    if(is_conditional(opcode)) {
+        fprintf(fp, "    }\n");
+    }
+}
+
+bool is_conditional(const opcode_t* opcode) {
+    return opcode->kind != OPCODE_RST && opcode->code != NULL && strcmp(opcode->code, "true") != 0;
+}
+
+void emit_exit(FILE* fp, const char* indent, uint16_t pc) {
+    fprintf(fp, "%si8080->pc = 0x%04x;\n", indent, pc);
+    fprintf(fp, "%sreturn;\n", indent);
+}
+
+void emit_branch(FILE* fp, const char* indent, uint16_t target) {
+    if(block_start[target]) {
+        fprintf(fp, "%sgoto block_%04x;\n", indent, target);
+    } else {
+        emit_exit(fp, indent, target);
+    }
+}
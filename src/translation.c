@@ -0,0 +1,44 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "translation.h"
+
+translation_state_t* init_translation_state(const translation_t* translation) {
+    translation_state_t* state = calloc(1, sizeof(translation_state_t));
+    if(state == NULL) {
+        return NULL;
+    }
+
+    state->dirty_blocks = calloc(translation->block_count > 0 ? translation->block_count : 1, sizeof(uint8_t));
+    if(state->dirty_blocks == NULL) {
+        free(state);
+        return NULL;
+    }
+
+    state->translation = translation;
+    memcpy(state->code_map, translation->code_map, sizeof(state->code_map));
+    return state;
+}
+
+void free_translation_state(translation_state_t* state) {
+    if(state == NULL) {
+        return;
+    }
+
+    free(state->dirty_blocks);
+    free(state);
+}
+
+void translation_invalidate(translation_state_t* state, uint16_t address) {
+    // only the first write to each translated byte gets here, so a linear scan of the
+    // blocks is cheap even for programs that keep rewriting the same instruction
+    const translation_t* translation = state->translation;
+    for(int block = 0; block < translation->block_count; ++block) {
+        if(address >= translation->block_starts[block] && address <= translation->block_ends[block]) {
+            state->dirty_blocks[block] = 1;
+        }
+    }
+
+    state->code_map[address >> 3] &= ~(1 << (address & 7));
+    state->exit_requested = true;
+}
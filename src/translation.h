@@ -0,0 +1,55 @@
+#ifndef __TRANSLATION_H__
+#define __TRANSLATION_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "i8080.h"
+
+// Interface between a program translated ahead of time by the recompiler and the
+// runtime that drives it.
+//
+// translation_t.run executes translated code starting at i8080->pc and returns with
+// i8080->pc set to the next instruction whenever it cannot continue: the address is
+// not the start of a translated block (a computed PCHL or RET target, code outside
+// the image), the block was overwritten, or a store just overwrote translated code.
+// The runtime then executes instructions with decode_i8080 until pc reaches an intact
+// translated block again. Interrupts are only accepted while the runtime is in control.
+
+typedef struct translation_state_t translation_state_t;
+
+typedef struct translation_t {
+    uint16_t origin;
+    uint32_t image_size;
+    const uint8_t* image;          // the original program, loaded at origin
+    const uint8_t* code_map;       // one bit per address that holds translated code
+    int block_count;
+    const uint16_t* block_starts;  // first and last byte of every block, by block number
+    const uint16_t* block_ends;
+    int instruction_count;
+    void (*run)(i8080_t* i8080, translation_state_t* state);
+} translation_t;
+
+struct translation_state_t {
+    const translation_t* translation;
+    uint8_t code_map[0x2000];      // translated code that has not been overwritten yet
+    uint8_t* dirty_blocks;         // blocks that must not run anymore, by block number
+    bool exit_requested;           // set by a store into translated code, checked after every store
+};
+
+translation_state_t* init_translation_state(const translation_t* translation);
+void free_translation_state(translation_state_t* state);
+void translation_invalidate(translation_state_t* state, uint16_t address);
+
+// Called by the embedder's write_byte for every guest write that changes memory, like
+// video_notify_write. Blocks containing an overwritten byte are left to the interpreter.
+// The translated code and the interpreter must use a write policy that gets here: with
+// I8080_FLAT_MEMORY that means calling it from I8080_ON_WRITE (see i8080_instr.h),
+// otherwise overwritten blocks keep running their stale translation.
+static inline void translation_notify_write(translation_state_t* state, uint16_t address) {
+    if(state->code_map[address >> 3] & (1 << (address & 7))) {
+        translation_invalidate(state, address);
+    }
+}
+
+#endif // __TRANSLATION_H__
@@ -0,0 +1,149 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+
+#include "i8080.h"
+#include "translation.h"
+
+// Runs a CP/M program translated by the recompiler, then runs the same program on the
+// interpreter and reports the speedup. The program is embedded in the translation.
+
+extern const translation_t translation;
+
+static const int MEMORY_SIZE = 0x10000;
+static uint8_t* memory;
+static translation_state_t* state;
+
+static uint8_t read_byte(uint16_t address);
+static void write_byte(uint16_t address, uint8_t byte);
+static i8080_t* load_program(void);
+static void bdos_call(i8080_t* i8080);
+static double run_translated(unsigned long* interpreted_instructions);
+static double run_interpreted(unsigned long* interpreted_instructions);
+static double elapsed_seconds(const struct timespec* start, const struct timespec* end);
+
+int main(int argc, char* argv[]) {
+    memory = calloc(MEMORY_SIZE, sizeof(uint8_t));
+    if(memory == NULL) {
+        printf("Error could not allocate memory\n");
+        return 1;
+    }
+
+    printf("=====================================\n");
+    printf("Translated: %d instructions in %d blocks\n", translation.instruction_count, translation.block_count);
+    printf("=====================================\n");
+
+    unsigned long fallback_instructions, instructions;
+    double translated_seconds = run_translated(&fallback_instructions);
+    printf("=====================================\n");
+    double interpreted_seconds = run_interpreted(&instructions);
+    printf("=====================================\n");
+
+    printf("Translated: %.3lf seconds, %lu instructions interpreted as fallback\n", translated_seconds, fallback_instructions);
+    printf("Interpreted: %.3lf seconds, %lu instructions\n", interpreted_seconds, instructions);
+    printf("Speedup: %.2lfx\n", interpreted_seconds / translated_seconds);
+
+    free(memory);
+    return 0;
+}
+
+uint8_t read_byte(uint16_t address) {
+    return memory[address];
+}
+
+void write_byte(uint16_t address, uint8_t byte) {
+    if(memory[address] != byte && state != NULL) {
+        translation_notify_write(state, address);
+    }
+    memory[address] = byte;
+}
+
+i8080_t* load_program(void) {
+    memset(memory, 0, MEMORY_SIZE);
+    memcpy(memory + translation.origin, translation.image, translation.image_size);
+    memory[0x0005] = 0xc9; // BDOS entry returns straight away, the call is serviced by bdos_call
+
+    i8080_t* i8080 = init_i8080(translation.origin);
+    i8080->read_byte = read_byte;
+    i8080->write_byte = write_byte;
+    return i8080;
+}
+
+void bdos_call(i8080_t* i8080) {
+    if(i8080->c == 0x09) {
+        // print characters until '$' (ascii 0x24) character is reached
+        for(uint16_t address = i8080->de; memory[address] != 0x24; ++address) {
+            printf("%c", memory[address]);
+        }
+    }
+
+    if(i8080->c == 0x02) {
+        printf("%c", i8080->e);
+    }
+}
+
+double run_translated(unsigned long* interpreted_instructions) {
+    i8080_t* i8080 = load_program();
+    *interpreted_instructions = 0;
+    state = init_translation_state(&translation);
+    if(state == NULL) {
+        printf("Error could not allocate the translation state\n");
+        free_i8080(i8080);
+        return 0;
+    }
+
+    struct timespec start_time, end_time;
+    timespec_get(&start_time, TIME_UTC);
+
+    while(true) {
+        translation.run(i8080, state);
+        if(i8080->pc == 0x0000) {
+            break;
+        }
+
+        // the translated code returned at an address it could not resolve, interpret one instruction
+        if(i8080->pc == 0x0005) {
+            bdos_call(i8080);
+        }
+
+        decode_i8080(i8080);
+        (*interpreted_instructions)++;
+
+        if(i8080->pc == 0x0000) {
+            break;
+        }
+    }
+
+    timespec_get(&end_time, TIME_UTC);
+    free_translation_state(state);
+    state = NULL;
+    free_i8080(i8080);
+    return elapsed_seconds(&start_time, &end_time);
+}
+
+double run_interpreted(unsigned long* interpreted_instructions) {
+    i8080_t* i8080 = load_program();
+    *interpreted_instructions = 0;
+
+    struct timespec start_time, end_time;
+    timespec_get(&start_time, TIME_UTC);
+
+    while(i8080->pc != 0x0000) {
+        if(i8080->pc == 0x0005) {
+            bdos_call(i8080);
+        }
+
+        decode_i8080(i8080);
+        (*interpreted_instructions)++;
+    }
+
+    timespec_get(&end_time, TIME_UTC);
+    free_i8080(i8080);
+    return elapsed_seconds(&start_time, &end_time);
+}
+
+double elapsed_seconds(const struct timespec* start, const struct timespec* end) {
+    return (end->tv_sec - start->tv_sec) + (end->tv_nsec - start->tv_nsec) / 1e9;
+}
@@ -0,0 +1,471 @@
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include "usart.h"
+
+#define USART_BUFFER_MASK (USART_BUFFER_SIZE - 1)
+#define USART_LOOP_MAX_EVENTS 64
+
+// Ring Buffer Functions
+static uint32_t buffer_count(const usart_buffer_t* buffer);
+static uint32_t buffer_space(const usart_buffer_t* buffer);
+
+// Host Side Functions
+static bool set_non_blocking(int fd);
+static uint64_t event_data(usart_t* usart, bool listener);
+static bool loop_register(usart_loop_t* loop, usart_t* usart, int fd, bool listener);
+static void loop_unregister(usart_loop_t* loop, usart_t* usart);
+static void update_interest(usart_loop_t* loop, usart_t* usart);
+static void receive(usart_t* usart);
+static void transmit(usart_t* usart);
+static void accept_connection(usart_loop_t* loop, usart_t* usart);
+static void disconnect(usart_t* usart);
+
+usart_t* init_usart(uint8_t base_port, uint8_t interrupt_opcode) {
+    usart_t* usart = calloc(1, sizeof(usart_t));
+    if(usart == NULL) {
+        return NULL;
+    }
+
+    usart->base_port = base_port;
+    usart->interrupt_opcode = interrupt_opcode;
+    usart->expecting_mode = true;
+    usart->fd = -1;
+    usart->listen_fd = -1;
+    usart->slave_fd = -1;
+    usart->slot = -1;
+    return usart;
+}
+
+void free_usart(usart_t* usart) {
+    if(usart == NULL) {
+        return;
+    }
+
+    if(usart->fd >= 0) {
+        close(usart->fd);
+    }
+
+    if(usart->slave_fd >= 0) {
+        close(usart->slave_fd);
+    }
+
+    if(usart->listen_fd >= 0) {
+        close(usart->listen_fd);
+        unlink(usart->device_name);
+    }
+
+    free(usart);
+}
+
+bool usart_open_pty(usart_t* usart) {
+    int fd = posix_openpt(O_RDWR | O_NOCTTY);
+    if(fd < 0 || grantpt(fd) != 0 || unlockpt(fd) != 0 || ptsname_r(fd, usart->device_name, sizeof(usart->device_name)) != 0) {
+        printf("Error could not open a pseudo-terminal: %s\n", strerror(errno));
+        if(fd >= 0) {
+            close(fd);
+        }
+        return false;
+    }
+
+    // keep the slave side open ourselves so the master does not report a hang up
+    // while no terminal is attached, and put it in raw mode so bytes pass through as is
+    int slave_fd = open(usart->device_name, O_RDWR | O_NOCTTY);
+    struct termios attributes;
+    if(slave_fd < 0 || tcgetattr(slave_fd, &attributes) != 0) {
+        printf("Error could not open the pseudo-terminal '%s': %s\n", usart->device_name, strerror(errno));
+        close(fd);
+        if(slave_fd >= 0) {
+            close(slave_fd);
+        }
+        return false;
+    }
+
+    cfmakeraw(&attributes);
+    tcsetattr(slave_fd, TCSANOW, &attributes);
+
+    if(!set_non_blocking(fd)) {
+        close(fd);
+        close(slave_fd);
+        return false;
+    }
+
+    usart->fd = fd;
+    usart->slave_fd = slave_fd;
+    usart->connected = true;
+    return true;
+}
+
+bool usart_open_socket(usart_t* usart, const char* socket_path) {
+    struct sockaddr_un address;
+    if(strlen(socket_path) >= sizeof(address.sun_path)) {
+        printf("Error the socket path '%s' is too long.\n", socket_path);
+        return false;
+    }
+
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strcpy(address.sun_path, socket_path);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if(fd < 0) {
+        printf("Error could not create a socket: %s\n", strerror(errno));
+        return false;
+    }
+
+    unlink(socket_path);
+    if(bind(fd, (struct sockaddr*)&address, sizeof(address)) != 0 || listen(fd, 1) != 0) {
+        printf("Error could not listen on '%s': %s\n", socket_path, strerror(errno));
+        close(fd);
+        return false;
+    }
+
+    usart->listen_fd = fd;
+    strcpy(usart->device_name, socket_path);
+    return true;
+}
+
+// Guest Side Functions
+// These only touch the buffered state, the host file descriptors are serviced by usart_loop_poll.
+uint8_t usart_read_port(usart_t* usart, uint8_t port) {
+    if(port == usart->base_port) {
+        if(buffer_count(&usart->rx) == 0) {
+            return 0x00;
+        }
+
+        return usart->rx.data[usart->rx.tail++ & USART_BUFFER_MASK];
+    }
+
+    // TxRDY in the status register only means the transmit buffer has room, unlike
+    // the TxRDY pin it is not gated by the transmit enable bit
+    uint8_t status = 0x00;
+    if(buffer_space(&usart->tx) > 0) {
+        status |= USART_STATUS_TXRDY;
+    }
+    if(buffer_count(&usart->rx) > 0) {
+        status |= USART_STATUS_RXRDY;
+    }
+    if(buffer_count(&usart->tx) == 0) {
+        status |= USART_STATUS_TXEMPTY;
+    }
+    if(usart->connected) {
+        status |= USART_STATUS_DSR;
+    }
+    return status;
+}
+
+void usart_write_port(usart_t* usart, uint8_t port, uint8_t value) {
+    if(port == usart->base_port) {
+        // like the real part, a byte written while the transmitter is full is lost
+        if(buffer_space(&usart->tx) > 0) {
+            usart->tx.data[usart->tx.head++ & USART_BUFFER_MASK] = value;
+        }
+        return;
+    }
+
+    if(usart->expecting_mode) {
+        // the mode instruction only describes the line format, which does not apply to a host stream
+        usart->mode = value;
+        usart->expecting_mode = false;
+        return;
+    }
+
+    if(value & USART_COMMAND_IR) {
+        usart->command = 0x00;
+        usart->expecting_mode = true;
+        return;
+    }
+
+    usart->command = value;
+}
+
+uint8_t usart_port_in(void* context, uint8_t port) {
+    usart_t* usart = context;
+    if(port != usart->base_port && port != (uint8_t)(usart->base_port + 1)) {
+        return 0xff;
+    }
+    return usart_read_port(usart, port);
+}
+
+void usart_port_out(void* context, uint8_t port, uint8_t value) {
+    usart_t* usart = context;
+    if(port != usart->base_port && port != (uint8_t)(usart->base_port + 1)) {
+        return;
+    }
+    usart_write_port(usart, port, value);
+}
+
+// Event Loop Functions
+usart_loop_t* init_usart_loop(void) {
+    usart_loop_t* loop = calloc(1, sizeof(usart_loop_t));
+    if(loop == NULL) {
+        return NULL;
+    }
+
+    loop->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if(loop->epoll_fd < 0) {
+        printf("Error could not create the event loop: %s\n", strerror(errno));
+        free(loop);
+        return NULL;
+    }
+
+    return loop;
+}
+
+void free_usart_loop(usart_loop_t* loop) {
+    if(loop == NULL) {
+        return;
+    }
+
+    // the usarts are owned by the caller
+    for(int i = 0; i < loop->usart_count; ++i) {
+        loop->usarts[i]->slot = -1;
+    }
+
+    close(loop->epoll_fd);
+    free(loop->usarts);
+    free(loop);
+}
+
+bool usart_loop_add(usart_loop_t* loop, usart_t* usart) {
+    if(usart->slot >= 0) {
+        return false;
+    }
+
+    if(loop->usart_count == loop->usart_capacity) {
+        int capacity = loop->usart_capacity == 0 ? 16 : loop->usart_capacity * 2;
+        usart_t** usarts = realloc(loop->usarts, capacity * sizeof(usart_t*));
+        if(usarts == NULL) {
+            return false;
+        }
+        loop->usarts = usarts;
+        loop->usart_capacity = capacity;
+    }
+
+    if(usart->listen_fd >= 0 && !loop_register(loop, usart, usart->listen_fd, true)) {
+        return false;
+    }
+
+    if(usart->fd >= 0 && !loop_register(loop, usart, usart->fd, false)) {
+        // leave the usart as it was so the caller can retry or free it
+        loop_unregister(loop, usart);
+        return false;
+    }
+
+    usart->slot = loop->usart_count;
+    loop->usarts[loop->usart_count++] = usart;
+    return true;
+}
+
+bool usart_loop_remove(usart_loop_t* loop, usart_t* usart) {
+    if(usart->slot < 0 || usart->slot >= loop->usart_count || loop->usarts[usart->slot] != usart) {
+        return false;
+    }
+
+    loop_unregister(loop, usart);
+
+    // the events carry the usart itself rather than its slot, so moving the last
+    // usart into the freed slot does not invalidate anything registered with epoll
+    usart_t* last = loop->usarts[--loop->usart_count];
+    loop->usarts[usart->slot] = last;
+    last->slot = usart->slot;
+    usart->slot = -1;
+    return true;
+}
+
+int usart_loop_poll(usart_loop_t* loop, int timeout_ms) {
+    // flush what the guests wrote since the last poll and re-arm the receivers that
+    // had filled up, then wait for host traffic on every usart at once
+    for(int i = 0; i < loop->usart_count; ++i) {
+        usart_t* usart = loop->usarts[i];
+        if(usart->connected) {
+            transmit(usart);
+            update_interest(loop, usart);
+        }
+    }
+
+    struct epoll_event events[USART_LOOP_MAX_EVENTS];
+    int event_count = epoll_wait(loop->epoll_fd, events, USART_LOOP_MAX_EVENTS, timeout_ms);
+    if(event_count < 0) {
+        return errno == EINTR ? 0 : -1;
+    }
+
+    for(int i = 0; i < event_count; ++i) {
+        usart_t* usart = (usart_t*)(uintptr_t)(events[i].data.u64 & ~(uint64_t)1);
+        bool listener = events[i].data.u64 & 1;
+
+        if(listener) {
+            accept_connection(loop, usart);
+            continue;
+        }
+
+        if(events[i].events & EPOLLIN) {
+            receive(usart);
+        }
+        if(usart->connected && (events[i].events & EPOLLOUT)) {
+            transmit(usart);
+        }
+        if(usart->connected && (events[i].events & (EPOLLHUP | EPOLLERR)) && !(events[i].events & EPOLLIN)) {
+            disconnect(usart);
+        }
+        if(usart->connected) {
+            update_interest(loop, usart);
+        }
+    }
+
+    return event_count;
+}
+
+// Ring Buffer Functions
+uint32_t buffer_count(const usart_buffer_t* buffer) {
+    return buffer->head - buffer->tail;
+}
+
+uint32_t buffer_space(const usart_buffer_t* buffer) {
+    return USART_BUFFER_SIZE - buffer_count(buffer);
+}
+
+// Host Side Functions
+bool set_non_blocking(int fd) {
+    int flags = fcntl(fd, F_GETFL);
+    if(flags < 0 || fcntl(fd, F_SETFL, flags | O_NONBLOCK) != 0) {
+        printf("Error could not make the file descriptor non-blocking: %s\n", strerror(errno));
+        return false;
+    }
+    return true;
+}
+
+uint64_t event_data(usart_t* usart, bool listener) {
+    // the usart pointer tagged with whether the descriptor is the listening socket,
+    // usarts are allocated with calloc so the lowest bit is always free
+    return (uint64_t)(uintptr_t)usart | listener;
+}
+
+bool loop_register(usart_loop_t* loop, usart_t* usart, int fd, bool listener) {
+    struct epoll_event event;
+    event.events = EPOLLIN;
+    event.data.u64 = event_data(usart, listener);
+
+    if(epoll_ctl(loop->epoll_fd, EPOLL_CTL_ADD, fd, &event) != 0) {
+        printf("Error could not add the usart to the event loop: %s\n", strerror(errno));
+        return false;
+    }
+
+    if(!listener) {
+        usart->registered_events = EPOLLIN;
+    }
+    return true;
+}
+
+void loop_unregister(usart_loop_t* loop, usart_t* usart) {
+    // descriptors that were never added just fail with ENOENT
+    if(usart->listen_fd >= 0) {
+        epoll_ctl(loop->epoll_fd, EPOLL_CTL_DEL, usart->listen_fd, NULL);
+    }
+
+    if(usart->fd >= 0) {
+        epoll_ctl(loop->epoll_fd, EPOLL_CTL_DEL, usart->fd, NULL);
+        usart->registered_events = 0;
+    }
+}
+
+void update_interest(usart_loop_t* loop, usart_t* usart) {
+    // only wait for input while there is room to store it and only wait for the
+    // descriptor to become writable while a previous write came up short
+    uint32_t wanted_events = 0;
+    if(buffer_space(&usart->rx) > 0) {
+        wanted_events |= EPOLLIN;
+    }
+    if(buffer_count(&usart->tx) > 0) {
+        wanted_events |= EPOLLOUT;
+    }
+
+    if(wanted_events == usart->registered_events) {
+        return;
+    }
+
+    struct epoll_event event;
+    event.events = wanted_events;
+    event.data.u64 = event_data(usart, false);
+    if(epoll_ctl(loop->epoll_fd, EPOLL_CTL_MOD, usart->fd, &event) == 0) {
+        usart->registered_events = wanted_events;
+    }
+}
+
+void receive(usart_t* usart) {
+    while(buffer_space(&usart->rx) > 0) {
+        uint32_t index = usart->rx.head & USART_BUFFER_MASK;
+        uint32_t length = USART_BUFFER_SIZE - index;
+        if(length > buffer_space(&usart->rx)) {
+            length = buffer_space(&usart->rx);
+        }
+
+        ssize_t received = read(usart->fd, usart->rx.data + index, length);
+        if(received > 0) {
+            usart->rx.head += received;
+            continue;
+        }
+
+        if(received == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+            // a pty master reports EIO once the attached terminal goes away
+            if(usart->listen_fd >= 0) {
+                disconnect(usart);
+            }
+        }
+        return;
+    }
+}
+
+void transmit(usart_t* usart) {
+    while(buffer_count(&usart->tx) > 0) {
+        uint32_t index = usart->tx.tail & USART_BUFFER_MASK;
+        uint32_t length = USART_BUFFER_SIZE - index;
+        if(length > buffer_count(&usart->tx)) {
+            length = buffer_count(&usart->tx);
+        }
+
+        ssize_t sent = write(usart->fd, usart->tx.data + index, length);
+        if(sent <= 0) {
+            return;
+        }
+        usart->tx.tail += sent;
+    }
+}
+
+void accept_connection(usart_loop_t* loop, usart_t* usart) {
+    int fd = accept4(usart->listen_fd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+    if(fd < 0) {
+        return;
+    }
+
+    // one terminal per usart, later connections are turned away
+    if(usart->connected) {
+        close(fd);
+        return;
+    }
+
+    usart->fd = fd;
+    usart->connected = true;
+    if(!loop_register(loop, usart, fd, false)) {
+        disconnect(usart);
+    }
+}
+
+void disconnect(usart_t* usart) {
+    // closing the descriptor also removes it from the epoll set
+    close(usart->fd);
+    usart->fd = -1;
+    usart->connected = false;
+    usart->registered_events = 0;
+    usart->tx.tail = usart->tx.head;
+}
@@ -0,0 +1,96 @@
+#ifndef __USART_H__
+#define __USART_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// An 8251-style USART with the data register at base_port and the mode/command and
+// status registers at base_port + 1. The host side is a pseudo-terminal or a Unix
+// domain socket; all host I/O happens in usart_loop_poll, so guest reads of the
+// status and data ports are served from the buffered state without any syscall.
+//
+// The receive buffer applies back pressure instead of overrunning: the host side is
+// not read while it is full, so the overrun error bit is never reported.
+//
+// A usart_loop_t serves any number of USARTs from the thread that also runs the
+// emulated CPUs, nothing here is thread safe. USARTs can be added and removed while
+// the loop is running, between calls to usart_loop_poll.
+
+#define USART_BUFFER_SIZE 1024 // must be a power of two
+
+// Status register bits
+#define USART_STATUS_TXRDY   0x01
+#define USART_STATUS_RXRDY   0x02
+#define USART_STATUS_TXEMPTY 0x04
+#define USART_STATUS_PE      0x08
+#define USART_STATUS_OE      0x10
+#define USART_STATUS_FE      0x20
+#define USART_STATUS_SYNDET  0x40
+#define USART_STATUS_DSR     0x80
+
+// Command register bits
+#define USART_COMMAND_TXEN   0x01
+#define USART_COMMAND_DTR    0x02
+#define USART_COMMAND_RXE    0x04
+#define USART_COMMAND_SBRK   0x08
+#define USART_COMMAND_ER     0x10
+#define USART_COMMAND_RTS    0x20
+#define USART_COMMAND_IR     0x40
+#define USART_COMMAND_EH     0x80
+
+typedef struct usart_buffer_t {
+    uint8_t data[USART_BUFFER_SIZE];
+    uint32_t head, tail; // free running, head - tail is the number of buffered bytes
+} usart_buffer_t;
+
+typedef struct usart_t {
+    uint8_t base_port;
+    uint8_t interrupt_opcode; // RST instruction supplied to the cpu on receive, e.g. 0xff for RST 7
+
+    bool expecting_mode;
+    uint8_t mode, command;
+
+    int fd;                   // connected pty master or socket, -1 if none
+    int slave_fd;             // pty slave held open while no terminal is attached, -1 if none
+    int listen_fd;            // listening socket, -1 if none
+    bool connected;
+    uint32_t registered_events;
+    char device_name[108];    // pty slave path or socket path
+
+    usart_buffer_t rx, tx;
+
+    int slot;                 // index in the owning loop, -1 if not registered
+} usart_t;
+
+typedef struct usart_loop_t {
+    int epoll_fd;
+    usart_t** usarts;
+    int usart_count, usart_capacity;
+} usart_loop_t;
+
+usart_t* init_usart(uint8_t base_port, uint8_t interrupt_opcode);
+void free_usart(usart_t* usart);
+bool usart_open_pty(usart_t* usart);
+bool usart_open_socket(usart_t* usart, const char* socket_path);
+
+uint8_t usart_read_port(usart_t* usart, uint8_t port);
+void usart_write_port(usart_t* usart, uint8_t port, uint8_t value);
+
+// Port handlers that can be assigned directly to i8080_t's read_port/write_port
+// with the USART as io_context, when it is the only device on the bus.
+uint8_t usart_port_in(void* context, uint8_t port);
+void usart_port_out(void* context, uint8_t port, uint8_t value);
+
+usart_loop_t* init_usart_loop(void);
+void free_usart_loop(usart_loop_t* loop);
+bool usart_loop_add(usart_loop_t* loop, usart_t* usart);
+bool usart_loop_remove(usart_loop_t* loop, usart_t* usart); // must be called before free_usart
+int usart_loop_poll(usart_loop_t* loop, int timeout_ms);
+
+// Level triggered like the 8251 RxRDY pin: true while received data is waiting and
+// the receiver is enabled. Pass interrupt_opcode to interrupt_i8080 when this is set.
+static inline bool usart_interrupt_requested(const usart_t* usart) {
+    return (usart->command & USART_COMMAND_RXE) && usart->rx.head != usart->rx.tail;
+}
+
+#endif // __USART_H__
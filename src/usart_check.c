@@ -0,0 +1,209 @@
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include "i8080.h"
+#include "usart.h"
+
+// Runs an interrupt driven echo program against a USART over a Unix domain socket and a
+// pseudo-terminal, covering IN/OUT, interrupt injection and the event loop. The handler
+// ends in EI; RET and several bytes arrive at once, so the interrupt stays requested
+// while the handler returns: the stack must never hold more than one interrupt frame.
+
+static const int MEMORY_SIZE = 0x10000;
+static const uint16_t STACK_TOP = 0x1000;
+static const int MAX_BATCHES = 2000; // of BATCH_INSTRUCTIONS each, with a 1 ms poll in between
+static const int BATCH_INSTRUCTIONS = 1000;
+static uint8_t* memory;
+
+static const uint8_t ECHO_PROGRAM[] = {
+    0x31, 0x00, 0x10, // 0x0100: LXI SP, #0x1000
+    0x3e, 0x4e,       // MVI A, #0x4e (mode)
+    0xd3, 0x11,       // OUT #0x11
+    0x3e, 0x05,       // MVI A, #0x05 (TXEN | RXE)
+    0xd3, 0x11,       // OUT #0x11
+    0xfb,             // EI
+    0x76,             // 0x010c: HLT
+    0xc3, 0x0c, 0x01  // JMP 0x010c
+};
+
+static const uint8_t ECHO_HANDLER[] = {
+    0xf5,             // 0x0038: PUSH PSW
+    0xdb, 0x10,       // IN #0x10
+    0xd3, 0x10,       // OUT #0x10
+    0xf1,             // POP PSW
+    0xfb,             // EI
+    0xc9              // RET
+};
+
+static uint8_t read_byte(uint16_t address);
+static void write_byte(uint16_t address, uint8_t byte);
+static i8080_t* load_program(usart_t* usart);
+static int connect_socket(const char* socket_path);
+static int open_terminal(const char* device_name);
+static bool run_echo(i8080_t* i8080, usart_t* usart, usart_loop_t* loop, int fd, const char* text, uint16_t* lowest_sp);
+static bool wait_for_disconnect(i8080_t* i8080, usart_t* usart, usart_loop_t* loop);
+static bool check(bool condition, const char* description);
+
+int main(int argc, char* argv[]) {
+    memory = calloc(MEMORY_SIZE, sizeof(uint8_t));
+    usart_loop_t* loop = init_usart_loop();
+    if(memory == NULL || loop == NULL) {
+        printf("Error could not allocate memory\n");
+        return 1;
+    }
+
+    bool passed = true;
+    char socket_path[64];
+    snprintf(socket_path, sizeof(socket_path), "/tmp/i8080_usart_check_%d.sock", (int)getpid());
+
+    // Unix domain socket, including a terminal going away and a new one attaching
+    usart_t* usart = init_usart(0x10, 0xff);
+    passed &= check(usart != NULL && usart_open_socket(usart, socket_path), "socket usart opens");
+    passed &= check(usart_loop_add(loop, usart), "socket usart joins the loop");
+
+    i8080_t* i8080 = load_program(usart);
+    uint16_t lowest_sp = STACK_TOP;
+    passed &= check(usart_port_in(usart, 0x20) == 0xff, "unmapped port reads 0xff");
+    passed &= check(!interrupt_i8080(i8080, 0x00), "non-RST interrupt is rejected");
+
+    int fd = connect_socket(socket_path);
+    passed &= check(run_echo(i8080, usart, loop, fd, "hello, world", &lowest_sp), "socket echo");
+    passed &= check(lowest_sp >= STACK_TOP - 4, "interrupts do not nest across EI; RET");
+
+    close(fd);
+    passed &= check(wait_for_disconnect(i8080, usart, loop), "socket disconnect is noticed");
+
+    fd = connect_socket(socket_path);
+    passed &= check(run_echo(i8080, usart, loop, fd, "again", &lowest_sp), "socket echo after reconnecting");
+    close(fd);
+
+    passed &= check(usart_loop_remove(loop, usart), "socket usart leaves the loop");
+    free_i8080(i8080);
+    free_usart(usart);
+
+    // pseudo-terminal, skipped where the host has none
+    usart = init_usart(0x10, 0xff);
+    if(usart != NULL && usart_open_pty(usart)) {
+        passed &= check(usart_loop_add(loop, usart), "pty usart joins the loop");
+        i8080 = load_program(usart);
+        lowest_sp = STACK_TOP;
+
+        fd = open_terminal(usart->device_name);
+        passed &= check(run_echo(i8080, usart, loop, fd, "pty echo", &lowest_sp), "pty echo");
+        passed &= check(lowest_sp >= STACK_TOP - 4, "interrupts do not nest on the pty");
+        close(fd);
+
+        usart_loop_remove(loop, usart);
+        free_i8080(i8080);
+    } else {
+        printf("SKIP pty echo, no pseudo-terminal available\n");
+    }
+    free_usart(usart);
+
+    free_usart_loop(loop);
+    free(memory);
+
+    printf("%s\n", passed ? "All checks passed" : "Some checks failed");
+    return passed ? 0 : 1;
+}
+
+uint8_t read_byte(uint16_t address) {
+    return memory[address];
+}
+
+void write_byte(uint16_t address, uint8_t byte) {
+    memory[address] = byte;
+}
+
+i8080_t* load_program(usart_t* usart) {
+    memset(memory, 0, MEMORY_SIZE);
+    memcpy(memory + 0x0100, ECHO_PROGRAM, sizeof(ECHO_PROGRAM));
+    memcpy(memory + 0x0038, ECHO_HANDLER, sizeof(ECHO_HANDLER));
+
+    i8080_t* i8080 = init_i8080(0x0100);
+    i8080->read_byte = read_byte;
+    i8080->write_byte = write_byte;
+    i8080->io_context = usart;
+    i8080->read_port = usart_port_in;
+    i8080->write_port = usart_port_out;
+    return i8080;
+}
+
+int connect_socket(const char* socket_path) {
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strcpy(address.sun_path, socket_path);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0);
+    if(fd >= 0 && connect(fd, (struct sockaddr*)&address, sizeof(address)) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+int open_terminal(const char* device_name) {
+    int fd = open(device_name, O_RDWR | O_NOCTTY | O_NONBLOCK);
+    struct termios attributes;
+    if(fd >= 0 && tcgetattr(fd, &attributes) == 0) {
+        cfmakeraw(&attributes);
+        tcsetattr(fd, TCSANOW, &attributes);
+    }
+    return fd;
+}
+
+bool run_echo(i8080_t* i8080, usart_t* usart, usart_loop_t* loop, int fd, const char* text, uint16_t* lowest_sp) {
+    size_t length = strlen(text);
+    if(fd < 0 || write(fd, text, length) != (ssize_t)length) {
+        return false;
+    }
+
+    // the runtime loop the README describes: offer the interrupt between instructions
+    // and poll the host side between slices
+    char echoed[64];
+    size_t echoed_length = 0;
+    for(int batch = 0; batch < MAX_BATCHES && echoed_length < length; ++batch) {
+        for(int i = 0; i < BATCH_INSTRUCTIONS; ++i) {
+            if(usart_interrupt_requested(usart)) {
+                interrupt_i8080(i8080, usart->interrupt_opcode);
+            }
+            decode_i8080(i8080);
+            if(i8080->sp < *lowest_sp) {
+                *lowest_sp = i8080->sp;
+            }
+        }
+
+        usart_loop_poll(loop, 1);
+        ssize_t received = read(fd, echoed + echoed_length, sizeof(echoed) - echoed_length);
+        if(received > 0) {
+            echoed_length += received;
+        }
+    }
+
+    return echoed_length == length && memcmp(echoed, text, length) == 0;
+}
+
+bool wait_for_disconnect(i8080_t* i8080, usart_t* usart, usart_loop_t* loop) {
+    for(int batch = 0; batch < MAX_BATCHES && usart->connected; ++batch) {
+        for(int i = 0; i < BATCH_INSTRUCTIONS; ++i) {
+            decode_i8080(i8080);
+        }
+        usart_loop_poll(loop, 1);
+    }
+    return !usart->connected;
+}
+
+bool check(bool condition, const char* description) {
+    printf("%s %s\n", condition ? "PASS" : "FAIL", description);
+    return condition;
+}
@@ -0,0 +1,185 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __SSE2__
+    #include <emmintrin.h>
+#endif
+
+#include "video.h"
+
+static void convert_line(video_t* video, int line);
+static void expand_bits(const uint8_t* source, int byte_count, uint8_t* destination,
+                        const uint8_t* foreground, const uint8_t* background, bool msb_first);
+
+video_t* init_video(const uint8_t* memory, uint16_t vram_address, int width, int height, bool msb_first) {
+    // each line must be a whole number of bytes and the video ram must not wrap around the address space
+    if(width <= 0 || height <= 0 || width % 8 != 0 || vram_address + (width / 8) * height > 0x10000) {
+        printf("Error invalid video layout %dx%d at 0x%04x\n", width, height, vram_address);
+        return NULL;
+    }
+
+    video_t* video = calloc(1, sizeof(video_t));
+    if(video == NULL) {
+        return NULL;
+    }
+
+    video->vram = memory + vram_address;
+    video->vram_address = vram_address;
+    video->width = width;
+    video->height = height;
+    video->bytes_per_line = width / 8;
+    video->vram_size = video->bytes_per_line * height;
+    video->msb_first = msb_first;
+    video->framebuffer = malloc((size_t)width * height * 4);
+    video->dirty_lines = calloc((height + 63) / 64, sizeof(uint64_t));
+
+    if(video->framebuffer == NULL || video->dirty_lines == NULL) {
+        free_video(video);
+        return NULL;
+    }
+
+    video_set_colors(video, 0xffffff, 0x000000);
+    return video;
+}
+
+void free_video(video_t* video) {
+    if(video == NULL) {
+        return;
+    }
+
+    free(video->framebuffer);
+    free(video->dirty_lines);
+    free(video);
+}
+
+void video_set_colors(video_t* video, uint32_t foreground_rgb, uint32_t background_rgb) {
+    video->foreground[0] = (foreground_rgb >> 16) & 0xff;
+    video->foreground[1] = (foreground_rgb >> 8) & 0xff;
+    video->foreground[2] = foreground_rgb & 0xff;
+    video->foreground[3] = 0xff;
+
+    video->background[0] = (background_rgb >> 16) & 0xff;
+    video->background[1] = (background_rgb >> 8) & 0xff;
+    video->background[2] = background_rgb & 0xff;
+    video->background[3] = 0xff;
+
+    // every pixel has to be converted again with the new colors
+    video_invalidate(video);
+}
+
+void video_invalidate(video_t* video) {
+    int words = (video->height + 63) / 64;
+    memset(video->dirty_lines, 0xff, words * sizeof(uint64_t));
+
+    // clear the bits past the last line so they are never converted
+    if(video->height % 64 != 0) {
+        video->dirty_lines[words - 1] = ((uint64_t)1 << (video->height % 64)) - 1;
+    }
+}
+
+int video_update(video_t* video) {
+    // converts the dirty lines into the framebuffer and returns how many were converted,
+    // a static screen only costs a scan of the dirty bitmap
+    int converted = 0;
+    int words = (video->height + 63) / 64;
+
+    for(int word = 0; word < words; ++word) {
+        uint64_t dirty = video->dirty_lines[word];
+        video->dirty_lines[word] = 0;
+
+        while(dirty != 0) {
+            int bit = __builtin_ctzll(dirty);
+            dirty &= dirty - 1;
+            convert_line(video, word * 64 + bit);
+            converted++;
+        }
+    }
+
+    video->frames++;
+    video->lines_converted += converted;
+    return converted;
+}
+
+bool video_write_ppm(video_t* video, const char* ppm_filename) {
+    FILE* fp = fopen(ppm_filename, "wb");
+    if(fp == NULL) {
+        printf("Error could not open the file '%s' for writing.\n", ppm_filename);
+        return false;
+    }
+
+    fprintf(fp, "P6\n%d %d\n255\n", video->width, video->height);
+
+    // the ppm format has no alpha channel so write the pixels one rgb triplet at a time
+    uint8_t* row = malloc((size_t)video->width * 3);
+    if(row == NULL) {
+        fclose(fp);
+        return false;
+    }
+
+    bool success = true;
+    for(int y = 0; y < video->height && success; ++y) {
+        const uint8_t* pixel = video->framebuffer + (size_t)y * video->width * 4;
+        for(int x = 0; x < video->width; ++x) {
+            row[x * 3 + 0] = pixel[x * 4 + 0];
+            row[x * 3 + 1] = pixel[x * 4 + 1];
+            row[x * 3 + 2] = pixel[x * 4 + 2];
+        }
+
+        success = fwrite(row, 3, video->width, fp) == (size_t)video->width;
+    }
+
+    free(row);
+    fclose(fp);
+
+    if(!success) {
+        printf("Error could not write the frame to '%s'.\n", ppm_filename);
+    }
+
+    return success;
+}
+
+void convert_line(video_t* video, int line) {
+    expand_bits(video->vram + line * video->bytes_per_line, video->bytes_per_line,
+                video->framebuffer + (size_t)line * video->width * 4,
+                video->foreground, video->background, video->msb_first);
+}
+
+#ifdef __SSE2__
+// Expands each source byte into 8 RGBA pixels: the byte is broadcast to all four
+// 32-bit lanes, masked with one bit per lane and compared to select foreground
+// or background, so 4 pixels are produced per compare.
+void expand_bits(const uint8_t* source, int byte_count, uint8_t* destination,
+                 const uint8_t* foreground, const uint8_t* background, bool msb_first) {
+    uint32_t foreground_pixel, background_pixel;
+    memcpy(&foreground_pixel, foreground, 4);
+    memcpy(&background_pixel, background, 4);
+
+    const __m128i foreground_vector = _mm_set1_epi32(foreground_pixel);
+    const __m128i background_vector = _mm_set1_epi32(background_pixel);
+    const __m128i first_bits = msb_first ? _mm_set_epi32(0x10, 0x20, 0x40, 0x80) : _mm_set_epi32(0x08, 0x04, 0x02, 0x01);
+    const __m128i second_bits = msb_first ? _mm_set_epi32(0x01, 0x02, 0x04, 0x08) : _mm_set_epi32(0x80, 0x40, 0x20, 0x10);
+
+    for(int i = 0; i < byte_count; ++i) {
+        __m128i byte = _mm_set1_epi32(source[i]);
+        __m128i first_mask = _mm_cmpeq_epi32(_mm_and_si128(byte, first_bits), first_bits);
+        __m128i second_mask = _mm_cmpeq_epi32(_mm_and_si128(byte, second_bits), second_bits);
+
+        __m128i first_pixels = _mm_or_si128(_mm_and_si128(first_mask, foreground_vector), _mm_andnot_si128(first_mask, background_vector));
+        __m128i second_pixels = _mm_or_si128(_mm_and_si128(second_mask, foreground_vector), _mm_andnot_si128(second_mask, background_vector));
+
+        _mm_storeu_si128((__m128i*)(destination + i * 32), first_pixels);
+        _mm_storeu_si128((__m128i*)(destination + i * 32 + 16), second_pixels);
+    }
+}
+#else
+void expand_bits(const uint8_t* source, int byte_count, uint8_t* destination,
+                 const uint8_t* foreground, const uint8_t* background, bool msb_first) {
+    for(int i = 0; i < byte_count; ++i) {
+        for(int bit = 0; bit < 8; ++bit) {
+            uint8_t mask = msb_first ? (0x80 >> bit) : (0x01 << bit);
+            memcpy(destination + (i * 8 + bit) * 4, (source[i] & mask) ? foreground : background, 4);
+        }
+    }
+}
+#endif
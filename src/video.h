@@ -0,0 +1,45 @@
+#ifndef __VIDEO_H__
+#define __VIDEO_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// A headless 1-bpp video device whose framebuffer lives in guest RAM, e.g. the
+// 256x224 layout at 0x2400. The embedder forwards guest writes through
+// video_notify_write, from its write_byte or from I8080_ON_WRITE when the core is
+// built with I8080_FLAT_MEMORY, which marks the touched line as dirty, and video_update
+// only converts the dirty lines into the host RGBA framebuffer.
+typedef struct video_t {
+    const uint8_t* vram;      // guest memory at vram_address
+    uint16_t vram_address;
+    uint32_t vram_size;
+    int width, height;
+    int bytes_per_line;
+    bool msb_first;           // true if the leftmost pixel of a byte is bit 7
+
+    uint8_t foreground[4], background[4]; // RGBA
+    uint8_t* framebuffer;     // width * height RGBA pixels
+    uint64_t* dirty_lines;    // one bit per line
+
+    unsigned long frames;
+    unsigned long lines_converted;
+} video_t;
+
+video_t* init_video(const uint8_t* memory, uint16_t vram_address, int width, int height, bool msb_first);
+void free_video(video_t* video);
+void video_set_colors(video_t* video, uint32_t foreground_rgb, uint32_t background_rgb);
+void video_invalidate(video_t* video);
+int video_update(video_t* video);
+bool video_write_ppm(video_t* video, const char* ppm_filename);
+
+// Called by the embedder's write_byte for every guest write, kept inline since it
+// sits on the memory write path and most writes fall outside video RAM.
+static inline void video_notify_write(video_t* video, uint16_t address) {
+    uint32_t offset = (uint16_t)(address - video->vram_address);
+    if(offset < video->vram_size) {
+        uint32_t line = offset / video->bytes_per_line;
+        video->dirty_lines[line >> 6] |= (uint64_t)1 << (line & 63);
+    }
+}
+
+#endif // __VIDEO_H__